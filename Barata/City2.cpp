@@ -1,47 +1,20 @@
 #include <iostream>
 #include <vector>
 #include <fstream>
-#include <sstream>
 #include <string>
 #include <limits>
 #include <algorithm>
 #include <chrono> // Inclui a biblioteca chrono para medir o tempo
 
+#include "../Common/CostMatrix.hpp"
+#include "../Common/BinaryMatrix.hpp"
+#include "../Common/CheapestInsertion.hpp"
+#include "../Common/LowerBound.hpp"
+
 using namespace std;
 using namespace chrono; // Facilita o uso das funções de medição de tempo
 
-typedef vector<vector<double>> Matrix;
-
-// Função para carregar a matriz de custos a partir de um arquivo CSV
-Matrix loadMatrixFromCSV(const string& filePath) {
-    Matrix matrix;
-    ifstream file(filePath);
-
-    if (!file.is_open()) {
-        cerr << "Erro ao abrir o arquivo: " << filePath << endl;
-        return matrix;
-    }
-
-    string line;
-    while (getline(file, line)) {
-        vector<double> row;
-        stringstream ss(line);
-        string value;
-
-        while (getline(ss, value, ',')) { // Usa vírgula como separador
-            try {
-                row.push_back(stod(value)); // Converte o valor para double
-            } catch (const invalid_argument&) {
-                row.push_back(0); // Adiciona 0 caso não consiga converter
-            }
-        }
-
-        matrix.push_back(row);
-    }
-
-    file.close();
-    return matrix;
-}
+typedef CostMatrix<COST_TYPE> Matrix;
 
 // Função para carregar os nomes das cidades de um arquivo CSV
 vector<string> loadCitiesFromCSV(const string& filePath) {
@@ -68,53 +41,23 @@ vector<string> loadCitiesFromCSV(const string& filePath) {
 double calculatePathCost(const vector<int>& path, const Matrix& costMatrix) {
     double cost = 0;
     for (size_t i = 0; i < path.size() - 1; ++i) {
-        cost += costMatrix[path[i]][path[i + 1]];
+        cost += costMatrix(path[i], path[i + 1]);
     }
     return cost;
 }
 
 // Algoritmo da Inserção Mais Barata (City Insertion)
+// A rota fica em uma lista ligada e cada cidade guarda a sua melhor aresta de inserção em um
+// heap; após cada inserção só as duas arestas novas são testadas (Common/CheapestInsertion.hpp)
 pair<vector<int>, double> insercaoMaisBarataCityInsertion(const Matrix& costMatrix) {
-    int n = costMatrix.size(); // Número de cidades
-
-    vector<int> route = {0, 1, 0}; // Começar com a cidade 0 e 1 e voltar à 0
-    vector<bool> visited(n, false);
-    visited[0] = true;
-    visited[1] = true;
-
-    while (route.size() < n + 1) {
-        double bestIncrease = numeric_limits<double>::infinity();
-        int bestCity = -1;
-        int bestPosition = -1;
-
-        for (int city = 0; city < n; ++city) {
-            if (visited[city]) continue;
-
-            for (int pos = 0; pos < route.size() - 1; ++pos) {
-                double increase = costMatrix[route[pos]][city] +
-                                 costMatrix[city][route[pos + 1]] -
-                                 costMatrix[route[pos]][route[pos + 1]];
-
-                if (increase < bestIncrease) {
-                    bestIncrease = increase;
-                    bestCity = city;
-                    bestPosition = pos;
-                }
-            }
-        }
-
-        // Inserir a melhor cidade encontrada na melhor posição
-        route.insert(route.begin() + bestPosition + 1, bestCity);
-        visited[bestCity] = true;
-    }
-
+    vector<int> route = cheapestInsertion(costMatrix);
     double bestCost = calculatePathCost(route, costMatrix);
 
     return {route, bestCost};
 }
 
 // Função para salvar os resultados em um arquivo CSV
-void saveResults(const string& outputFile, const string& mode, const vector<int>& route, double cost, const vector<string>& cities, double executionTime) {
+void saveResults(const string& outputFile, const string& mode, const vector<int>& route, double cost, const vector<string>& cities, double executionTime, double lowerBound) {
     ofstream outFile(outputFile, ios::app);
 
     if (!outFile.is_open()) {
@@ -124,7 +67,7 @@ void saveResults(const string& outputFile, const string& mode, const vector<int>
 
     static bool headerWritten = false;
     if (!headerWritten) {
-        outFile << "Modo,Rota,Custo,Tempo (s)\n";
+        outFile << "Modo,Rota,Custo,Tempo (s),Limite inferior,Gap (%)\n";
         headerWritten = true;
     }
 
@@ -132,7 +75,7 @@ void saveResults(const string& outputFile, const string& mode, const vector<int>
     for (int city : route) {
         outFile << cities[city] << " ";
     }
-    outFile << "\"," << cost << "," << executionTime << "\n";
+    outFile << "\"," << cost << "," << executionTime << "," << lowerBound << "," << optimalityGap(cost, lowerBound) << "\n";
 
     outFile.close();
 }
@@ -147,11 +90,11 @@ int main() {
 
     // Carregar a matriz de distâncias
     cout << "Carregando a matriz de distâncias..." << endl;
-    Matrix distanceMatrix = loadMatrixFromCSV(distanceFile);
+    Matrix distanceMatrix = loadMatrix(distanceFile);
 
     // Carregar a matriz de tempos
     cout << "Carregando a matriz de tempos..." << endl;
-    Matrix timeMatrix = loadMatrixFromCSV(timeFile);
+    Matrix timeMatrix = loadMatrix(timeFile);
 
     // Carregar os nomes das cidades
     cout << "Carregando os nomes das cidades..." << endl;
@@ -162,6 +105,10 @@ int main() {
         return 1;
     }
 
+    // Limites inferiores de Held e Karp, para o gap de cada solução
+    double distanceBound = heldKarpBound(distanceMatrix);
+    double timeBound = heldKarpBound(timeMatrix);
+
     // Medir tempo para Inserção Mais Barata com distâncias
     auto start = high_resolution_clock::now();
     auto [initialRouteDist, initialCostDist] = insercaoMaisBarataCityInsertion(distanceMatrix);
@@ -169,7 +116,8 @@ int main() {
     double executionTimeDist = duration_cast<duration<double>>(end - start).count();
 
     cout << "Custo inicial (Distância - Inserção Mais Barata): " << initialCostDist << " | Tempo: " << executionTimeDist << "s" << endl;
-    saveResults(outputFile, "Distância - Inserção Mais Barata", initialRouteDist, initialCostDist, cities, executionTimeDist);
+    cout << "Limite inferior (Distância): " << distanceBound << " | Gap: " << optimalityGap(initialCostDist, distanceBound) << "%" << endl;
+    saveResults(outputFile, "Distância - Inserção Mais Barata", initialRouteDist, initialCostDist, cities, executionTimeDist, distanceBound);
 
     // Medir tempo para Inserção Mais Barata com tempos
     start = high_resolution_clock::now();
@@ -178,7 +126,8 @@ int main() {
     double executionTimeTime = duration_cast<duration<double>>(end - start).count();
 
     cout << "Custo inicial (Tempo - Inserção Mais Barata): " << initialCostTime << " | Tempo: " << executionTimeTime << "s" << endl;
-    saveResults(outputFile, "Tempo - Inserção Mais Barata", initialRouteTime, initialCostTime, cities, executionTimeTime);
+    cout << "Limite inferior (Tempo): " << timeBound << " | Gap: " << optimalityGap(initialCostTime, timeBound) << "%" << endl;
+    saveResults(outputFile, "Tempo - Inserção Mais Barata", initialRouteTime, initialCostTime, cities, executionTimeTime, timeBound);
 
     return 0;
 }
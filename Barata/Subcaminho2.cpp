@@ -1,47 +1,23 @@
 #include <iostream>
 #include <vector>
 #include <fstream>
-#include <sstream>
 #include <string>
 #include <limits>
 #include <algorithm>
 #include <chrono> // Incluindo chrono para medir o tempo
 
+#include "../Common/CostMatrix.hpp"
+#include "../Common/BinaryMatrix.hpp"
+#include "../Common/CheapestInsertion.hpp"
+#include "../Common/NeighborLists.hpp"
+#include "../Common/LocalSearch.hpp"
+#include "../Common/TwoLevelRoute.hpp"
+#include "../Common/LowerBound.hpp"
+
 using namespace std;
 using namespace chrono; // Para facilitar o uso das funções de medição de tempo
 
-typedef vector<vector<double>> Matrix;
-
-// Função para carregar a matriz de custos a partir de um arquivo CSV
-Matrix loadMatrixFromCSV(const string& filePath) {
-    Matrix matrix;
-    ifstream file(filePath);
-
-    if (!file.is_open()) {
-        cerr << "Erro ao abrir o arquivo: " << filePath << endl;
-        return matrix;
-    }
-
-    string line;
-    while (getline(file, line)) {
-        vector<double> row;
-        stringstream ss(line);
-        string value;
-
-        while (getline(ss, value, ',')) { // Usa vírgula como separador
-            try {
-                row.push_back(stod(value)); // Converte o valor para double
-            } catch (const invalid_argument&) {
-                row.push_back(0); // Adiciona 0 caso não consiga converter
-            }
-        }
-
-        matrix.push_back(row);
-    }
-
-    file.close();
-    return matrix;
-}
+typedef CostMatrix<COST_TYPE> Matrix;
 
 // Função para carregar os nomes das cidades de um arquivo CSV
 vector<string> loadCitiesFromCSV(const string& filePath) {
@@ -68,82 +44,46 @@ vector<string> loadCitiesFromCSV(const string& filePath) {
 double calculatePathCost(const vector<int>& path, const Matrix& costMatrix) {
     double cost = 0;
     for (size_t i = 0; i < path.size() - 1; ++i) {
-        cost += costMatrix[path[i]][path[i + 1]];
+        cost += costMatrix(path[i], path[i + 1]);
     }
     return cost;
 }
 
 // Algoritmo da Inserção Mais Barata
+// A rota fica em uma lista ligada e cada cidade guarda a sua melhor aresta de inserção em um
+// heap; após cada inserção só as duas arestas novas são testadas (Common/CheapestInsertion.hpp)
 pair<vector<int>, double> insercaoMaisBarata(const Matrix& costMatrix) {
-    int n = costMatrix.size(); // Número de cidades
-
-    // Começar com duas cidades arbitrárias
-    vector<int> route = {0, 1, 0}; // Começa com a cidade 0 e 1 e retorna à 0
-    vector<bool> visited(n, false);
-    visited[0] = true;
-    visited[1] = true;
-
-    while (route.size() < n + 1) {
-        double bestIncrease = numeric_limits<double>::infinity();
-        int bestCity = -1;
-        int bestPosition = -1;
-
-        for (int city = 0; city < n; ++city) {
-            if (visited[city]) continue;
-
-            for (int pos = 0; pos < route.size() - 1; ++pos) {
-                double increase = costMatrix[route[pos]][city] +
-                                 costMatrix[city][route[pos + 1]] -
-                                 costMatrix[route[pos]][route[pos + 1]];
-
-                if (increase < bestIncrease) {
-                    bestIncrease = increase;
-                    bestCity = city;
-                    bestPosition = pos;
-                }
-            }
-        }
-
-        // Insere a melhor cidade encontrada na melhor posição
-        route.insert(route.begin() + bestPosition + 1, bestCity);
-        visited[bestCity] = true;
-    }
-
-    // Calcula o custo total da rota final
+    vector<int> route = cheapestInsertion(costMatrix);
     double bestCost = calculatePathCost(route, costMatrix);
 
     return {route, bestCost};
 }
 
 // Método de Reversão de Subcaminho (2-opt)
-pair<vector<int>, double> twoOpt(const vector<int>& initialPath, const Matrix& costMatrix) {
-    vector<int> bestPath = initialPath;
-    double bestCost = calculatePathCost(bestPath, costMatrix);
-    bool improved = true;
-
-    while (improved) {
-        improved = false;
-
-        for (size_t i = 1; i < bestPath.size() - 2; ++i) {
-            for (size_t j = i + 1; j < bestPath.size() - 1; ++j) {
-                vector<int> newPath = bestPath;
-                reverse(newPath.begin() + i, newPath.begin() + j + 1);
-
-                double newCost = calculatePathCost(newPath, costMatrix);
-                if (newCost < bestCost) {
-                    bestPath = newPath;
-                    bestCost = newCost;
-                    improved = true;
-                }
-            }
-        }
+// Usa o driver de busca local compartilhado (bits "não olhe" e variação de custo em O(1)).
+// Com listas de candidatos, a reversão só é tentada quando cria uma aresta entre vizinhos próximos.
+// Em instâncias grandes a rota fica na lista de dois níveis, onde cada reversão custa O(sqrt(n)).
+pair<vector<int>, double> twoOpt(const vector<int>& initialPath, const Matrix& costMatrix,
+                                 const NeighborLists* neighbors = nullptr) {
+    // O driver trabalha com a rota cíclica, sem repetir a cidade inicial no fim
+    vector<int> route(initialPath.begin(), initialPath.end() - 1);
+    if (route.size() >= TWO_LEVEL_MIN_CITIES) {
+        TwoOptNeighborhood<COST_TYPE, TwoLevelRoute> twoOptMoves(costMatrix, neighbors);
+        runLocalSearch<TwoLevelRoute>(route, {&twoOptMoves});
+    } else {
+        TwoOptNeighborhood<COST_TYPE> twoOptMoves(costMatrix, neighbors);
+        runLocalSearch(route, {&twoOptMoves});
     }
 
-    return {bestPath, bestCost};
+    // Volta a começar e terminar na cidade inicial
+    rotate(route.begin(), find(route.begin(), route.end(), initialPath.front()), route.end());
+    route.push_back(route.front());
+
+    return {route, calculatePathCost(route, costMatrix)};
 }
 
 // Função para salvar os resultados em um arquivo CSV
-void saveResults(const string& outputFile, const string& mode, const vector<int>& route, double cost, const vector<string>& cities, double executionTime) {
+void saveResults(const string& outputFile, const string& mode, const vector<int>& route, double cost, const vector<string>& cities, double executionTime, double lowerBound) {
     ofstream outFile(outputFile, ios::app);
 
     if (!outFile.is_open()) {
@@ -154,7 +94,7 @@ void saveResults(const string& outputFile, const string& mode, const vector<int>
     // Cabeçalho na primeira execução
     static bool headerWritten = false;
     if (!headerWritten) {
-        outFile << "Modo,Rota,Custo,Tempo (s)\n";
+        outFile << "Modo,Rota,Custo,Tempo (s),Limite inferior,Gap (%)\n";
         headerWritten = true;
     }
 
@@ -162,7 +102,7 @@ void saveResults(const string& outputFile, const string& mode, const vector<int>
     for (int city : route) {
         outFile << cities[city] << " ";
     }
-    outFile << "\"," << cost << "," << executionTime << "\n";
+    outFile << "\"," << cost << "," << executionTime << "," << lowerBound << "," << optimalityGap(cost, lowerBound) << "\n";
 
     outFile.close();
 }
@@ -177,11 +117,11 @@ int main() {
 
     // Carregar a matriz de distâncias
     cout << "Carregando a matriz de distâncias..." << endl;
-    Matrix distanceMatrix = loadMatrixFromCSV(distanceFile);
+    Matrix distanceMatrix = loadMatrix(distanceFile);
 
     // Carregar a matriz de tempos
     cout << "Carregando a matriz de tempos..." << endl;
-    Matrix timeMatrix = loadMatrixFromCSV(timeFile);
+    Matrix timeMatrix = loadMatrix(timeFile);
 
     // Carregar os nomes das cidades
     cout << "Carregando os nomes das cidades..." << endl;
@@ -193,6 +133,15 @@ int main() {
         return 1;
     }
 
+    // Limites inferiores de Held e Karp, para o gap de cada solução
+    double distanceBound = heldKarpBound(distanceMatrix);
+    double timeBound = heldKarpBound(timeMatrix);
+
+    // Listas de candidatos do 2-opt, montadas uma vez por matriz (0 vizinhos desativa)
+    int neighborCount = 10;
+    NeighborLists distanceNeighbors(distanceMatrix, neighborCount);
+    NeighborLists timeNeighbors(timeMatrix, neighborCount);
+
     // Medir tempo para Inserção Mais Barata com distâncias
     auto start = high_resolution_clock::now();
     auto [initialRouteDist, initialCostDist] = insercaoMaisBarata(distanceMatrix);
@@ -200,16 +149,18 @@ int main() {
     double executionTimeDist = duration_cast<duration<double>>(end - start).count();
 
     cout << "Custo inicial (Distância): " << initialCostDist << " | Tempo: " << executionTimeDist << "s" << endl;
-    saveResults(outputFile, "Distância - Inserção Mais Barata", initialRouteDist, initialCostDist, cities, executionTimeDist);
+    cout << "Limite inferior (Distância): " << distanceBound << " | Gap: " << optimalityGap(initialCostDist, distanceBound) << "%" << endl;
+    saveResults(outputFile, "Distância - Inserção Mais Barata", initialRouteDist, initialCostDist, cities, executionTimeDist, distanceBound);
 
     // Medir tempo para 2-opt com distâncias
     start = high_resolution_clock::now();
-    auto [optimizedRouteDist, optimizedCostDist] = twoOpt(initialRouteDist, distanceMatrix);
+    auto [optimizedRouteDist, optimizedCostDist] = twoOpt(initialRouteDist, distanceMatrix, &distanceNeighbors);
     end = high_resolution_clock::now();
     double executionTimeOptDist = duration_cast<duration<double>>(end - start).count();
 
     cout << "Custo otimizado (Distância - 2-opt): " << optimizedCostDist << " | Tempo: " << executionTimeOptDist << "s" << endl;
-    saveResults(outputFile, "Distância - 2-opt", optimizedRouteDist, optimizedCostDist, cities, executionTimeOptDist);
+    cout << "Limite inferior (Distância): " << distanceBound << " | Gap: " << optimalityGap(optimizedCostDist, distanceBound) << "%" << endl;
+    saveResults(outputFile, "Distância - 2-opt", optimizedRouteDist, optimizedCostDist, cities, executionTimeOptDist, distanceBound);
 
     // Medir tempo para Inserção Mais Barata com tempos
     start = high_resolution_clock::now();
@@ -218,16 +169,18 @@ int main() {
     double executionTimeTime = duration_cast<duration<double>>(end - start).count();
 
     cout << "Custo inicial (Tempo): " << initialCostTime << " | Tempo: " << executionTimeTime << "s" << endl;
-    saveResults(outputFile, "Tempo - Inserção Mais Barata", initialRouteTime, initialCostTime, cities, executionTimeTime);
+    cout << "Limite inferior (Tempo): " << timeBound << " | Gap: " << optimalityGap(initialCostTime, timeBound) << "%" << endl;
+    saveResults(outputFile, "Tempo - Inserção Mais Barata", initialRouteTime, initialCostTime, cities, executionTimeTime, timeBound);
 
     // Medir tempo para 2-opt com tempos
     start = high_resolution_clock::now();
-    auto [optimizedRouteTime, optimizedCostTime] = twoOpt(initialRouteTime, timeMatrix);
+    auto [optimizedRouteTime, optimizedCostTime] = twoOpt(initialRouteTime, timeMatrix, &timeNeighbors);
     end = high_resolution_clock::now();
     double executionTimeOptTime = duration_cast<duration<double>>(end - start).count();
 
     cout << "Custo otimizado (Tempo - 2-opt): " << optimizedCostTime << " | Tempo: " << executionTimeOptTime << "s" << endl;
-    saveResults(outputFile, "Tempo - 2-opt", optimizedRouteTime, optimizedCostTime, cities, executionTimeOptTime);
+    cout << "Limite inferior (Tempo): " << timeBound << " | Gap: " << optimalityGap(optimizedCostTime, timeBound) << "%" << endl;
+    saveResults(outputFile, "Tempo - 2-opt", optimizedRouteTime, optimizedCostTime, cities, executionTimeOptTime, timeBound);
 
     return 0;
 }
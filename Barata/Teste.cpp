@@ -1,46 +1,19 @@
 #include <iostream>
 #include <vector>
 #include <fstream>
-#include <sstream>
 #include <string>
 #include <algorithm>
 #include <chrono>
 
+#include "../Common/CostMatrix.hpp"
+#include "../Common/BinaryMatrix.hpp"
+#include "../Common/CheapestInsertion.hpp"
+#include "../Common/LowerBound.hpp"
+
 using namespace std;
 using namespace chrono;
 
-typedef vector<vector<double>> Matrix;
-
-// Função para carregar a matriz de custos de um arquivo .csv
-Matrix loadMatrixFromCSV(const string& filePath) {
-    Matrix matrix;
-    ifstream file(filePath);
-
-    if (!file.is_open()) {
-        cerr << "Erro ao abrir o arquivo: " << filePath << endl;
-        return matrix;
-    }
-
-    string line;
-    while (getline(file, line)) {
-        vector<double> row;
-        stringstream ss(line);
-        string value;
-
-        while (getline(ss, value, ',')) { // Usa vírgula como separador
-            try {
-                row.push_back(stod(value)); // Converte o valor para double
-            } catch (const invalid_argument&) {
-                row.push_back(0); // Adiciona 0 caso não consiga converter
-            }
-        }
-
-        matrix.push_back(row);
-    }
-
-    file.close();
-    return matrix;
-}
+typedef CostMatrix<COST_TYPE> Matrix;
 
 // Função para carregar os nomes das cidades
 vector<string> loadCitiesFromCSV(const string& filePath) {
@@ -72,45 +45,16 @@ vector<string> loadCitiesFromCSV(const string& filePath) {
 double calculatePathCost(const vector<int>& path, const Matrix& costMatrix) {
     double cost = 0;
     for (size_t i = 0; i < path.size() - 1; ++i) {
-        cost += costMatrix[path[i]][path[i + 1]];
+        cost += costMatrix(path[i], path[i + 1]);
     }
     return cost;
 }
 
 // Algoritmo da Inserção Mais Barata
+// A rota fica em uma lista ligada e cada cidade guarda a sua melhor aresta de inserção em um
+// heap; após cada inserção só as duas arestas novas são testadas (Common/CheapestInsertion.hpp)
 pair<vector<int>, double> insertionMaisBarata(const Matrix& costMatrix) {
-    int n = costMatrix.size(); // Número de cidades
-
-    vector<int> route = {0, 1, 0}; // Começar com a cidade 0 e 1 e voltar à 0
-    vector<bool> visited(n, false);
-    visited[0] = true;
-    visited[1] = true;
-
-    while (route.size() < n + 1) {
-        double bestIncrease = numeric_limits<double>::infinity();
-        int bestCity = -1;
-        int bestPosition = -1;
-
-        for (int city = 0; city < n; ++city) {
-            if (visited[city]) continue;
-
-            for (int pos = 0; pos < route.size() - 1; ++pos) {
-                double increase = costMatrix[route[pos]][city] +
-                                 costMatrix[city][route[pos + 1]] -
-                                 costMatrix[route[pos]][route[pos + 1]];
-
-                if (increase < bestIncrease) {
-                    bestIncrease = increase;
-                    bestCity = city;
-                    bestPosition = pos;
-                }
-            }
-        }
-
-        route.insert(route.begin() + bestPosition + 1, bestCity);
-        visited[bestCity] = true;
-    }
-
+    vector<int> route = cheapestInsertion(costMatrix);
     double bestCost = calculatePathCost(route, costMatrix);
 
     return {route, bestCost};
@@ -118,12 +62,7 @@ pair<vector<int>, double> insertionMaisBarata(const Matrix& costMatrix) {
 
 // Função para cortar a matriz e o vetor de cidades para o tamanho desejado
 pair<Matrix, vector<string>> sliceMatrixAndCities(const Matrix& costMatrix, const vector<string>& cities, int size) {
-    Matrix slicedMatrix(size, vector<double>(size));
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            slicedMatrix[i][j] = costMatrix[i][j];
-        }
-    }
+    Matrix slicedMatrix = costMatrix.slice(size);
 
     vector<string> slicedCities(cities.begin(), cities.begin() + size);
     return {slicedMatrix, slicedCities};
@@ -145,7 +84,7 @@ void executeAndCompare(const Matrix& costMatrix, const vector<string>& cities, c
     // Escrever cabeçalho apenas na primeira execução
     static bool headerWritten = false;
     if (!headerWritten) {
-        outFile << "Problema,Número de Cidades,Rota,Custo,Tempo(ms),Modo\n";
+        outFile << "Problema,Número de Cidades,Rota,Custo,Tempo(ms),Modo,Limite inferior,Gap (%)\n";
         headerWritten = true;
     }
 
@@ -155,31 +94,30 @@ void executeAndCompare(const Matrix& costMatrix, const vector<string>& cities, c
 
     auto duration = duration_cast<milliseconds>(end - start).count();
 
+    // Limite inferior de Held e Karp do problema (fora da medição de tempo), com a rota como guia
+    double lowerBound = heldKarpBound(costMatrix, cost);
+    double gap = optimalityGap(cost, lowerBound);
+
     // Registrar resultados
     outFile << problemNumber << "," << cities.size() << ",\"";
     for (int city : route) {
         outFile << cities[city] << " ";
     }
-    outFile << "\"," << cost << "," << duration << "," << mode << "\n";
+    outFile << "\"," << cost << "," << duration << "," << mode << "," << lowerBound << "," << gap << "\n";
 
     // Exibir no console
     cout << "Problema " << problemNumber << ": Rota encontrada: ";
     for (int city : route) {
         cout << cities[city] << " ";
     }
-    cout << "| Custo: " << cost << " | Tempo: " << duration << " ms | Modo: " << mode << endl;
+    cout << "| Custo: " << cost << " | Limite inferior: " << lowerBound << " | Gap: " << gap << "% | Tempo: " << duration
+         << " ms | Modo: " << mode << endl;
 
     outFile.close();
 }
 // Função para ajustar a matriz de custos para o número de cidades carregadas
 Matrix adjustMatrixToCities(const Matrix& originalMatrix, int cityCount) {
-    Matrix adjustedMatrix(cityCount, vector<double>(cityCount));
-    for (int i = 0; i < cityCount; ++i) {
-        for (int j = 0; j < cityCount; ++j) {
-            adjustedMatrix[i][j] = originalMatrix[i][j];
-        }
-    }
-    return adjustedMatrix;
+    return originalMatrix.slice(cityCount);
 }
 // Função principal
 int main() {
@@ -188,8 +126,8 @@ int main() {
     string citiesFile = "../Cidades.csv"; // Caminho do arquivo CSV com nomes das cidades
     string outputFile = "../resultados.csv"; // Arquivo de saída
 
-    Matrix distanceMatrix = loadMatrixFromCSV(distanceFile);
-    Matrix timeMatrix = loadMatrixFromCSV(timeFile);
+    Matrix distanceMatrix = loadMatrix(distanceFile);
+    Matrix timeMatrix = loadMatrix(timeFile);
     vector<string> cities = loadCitiesFromCSV(citiesFile);
 
     if (distanceMatrix.empty() || timeMatrix.empty() || cities.empty()) {
@@ -0,0 +1,376 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <map>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+#include "../Common/CostMatrix.hpp"
+#include "../Common/BinaryMatrix.hpp"
+#include "../Common/NeighborLists.hpp"
+#include "../Common/NearestNeighbor.hpp"
+#include "../Common/CheapestInsertion.hpp"
+#include "../Common/LocalSearch.hpp"
+#include "../Common/Grasp.hpp"
+#include "../Common/HeldKarp.hpp"
+#include "../Common/BranchAndBound.hpp"
+#include "../Common/LowerBound.hpp"
+
+using namespace std;
+using namespace chrono;
+
+// Define um tipo para matriz (matriz de custos contígua compartilhada)
+typedef CostMatrix<COST_TYPE> Matrix;
+
+// Um dos 12 problemas do TCC: as primeiras size cidades de uma das matrizes
+struct Problem {
+    int number;
+    string mode; // Distância ou Tempo
+    Matrix matrix;
+    NeighborLists neighbors;
+    double lowerBound; // Limite de Held e Karp (1-árvore com subgradiente)
+};
+
+// Algoritmo medido: recebe o problema e a semente da repetição e devolve o custo da rota
+struct Algorithm {
+    string name;
+    function<double(const Problem&, unsigned)> run;
+};
+
+// Estatísticas de um algoritmo em um problema
+struct Result {
+    int problem;
+    int cities;
+    string mode;
+    string algorithm;
+    int repetitions;
+    double minTime, medianTime, p95Time; // Em milissegundos
+    double minCost, medianCost;
+    double optimum; // NAN se não houver valor de referência
+    double gap;     // Em porcentagem sobre o ótimo (NAN sem ótimo)
+    double lowerBound;
+    double boundGap; // Em porcentagem sobre o limite inferior
+};
+
+struct Options {
+    string distanceFile = "../Km_modificado.csv";
+    string timeFile = "../Min_modificado.csv";
+    string optimaFile;            // CSV com os ótimos de referência (GLPK)
+    size_t exactMemoryMb = 256;   // Memória do Held-Karp para os ótimos que faltam (0: não calcula)
+    double exactTime = 10.0;      // Prazo do branch-and-bound para os ótimos que ainda faltam (0: não roda)
+    string jsonFile = "benchmark.json";
+    string csvFile = "benchmark.csv";
+    int repetitions = 10;         // Repetições medidas
+    int warmup = 2;               // Repetições descartadas antes das medidas
+    int graspIterations = 100;
+    unsigned seed = 1;            // Semente da primeira repetição (as demais somam o índice)
+    vector<string> algorithms;    // Vazio: todos
+};
+
+// Custo de um caminho fechado (a última cidade repete a primeira)
+double pathCost(const vector<int>& path, const Matrix& costMatrix) {
+    double cost = 0;
+    for (size_t i = 0; i + 1 < path.size(); ++i) {
+        cost += costMatrix(path[i], path[i + 1]);
+    }
+    return cost;
+}
+
+// Aplica uma busca local do driver compartilhado a um caminho fechado e devolve o novo custo
+double improvePath(vector<int>& path, const Problem& problem, LocalSearchMethod method) {
+    vector<int> route(path.begin(), path.end() - 1);
+    localSearch(route, problem.matrix, method, &problem.neighbors);
+    return cycleCost(route, problem.matrix);
+}
+
+vector<Algorithm> makeAlgorithms(const Options& options) {
+    int iterations = options.graspIterations;
+    auto graspWith = [iterations](LocalSearchMethod method) {
+        return [iterations, method](const Problem& problem, unsigned seed) {
+            return grasp(problem.matrix, iterations, 0.3, method, 1, seed, &problem.neighbors).second;
+        };
+    };
+    return {
+        {"greedy", [](const Problem& problem, unsigned) {
+             NearestNeighborBuilder<COST_TYPE> builder(problem.matrix, &problem.neighbors);
+             return builder.build(0).second;
+         }},
+        {"greedy+swap", [](const Problem& problem, unsigned) {
+             NearestNeighborBuilder<COST_TYPE> builder(problem.matrix, &problem.neighbors);
+             auto [path, cost] = builder.build(0);
+             return swapLocalSearch(path, problem.matrix, cost);
+         }},
+        {"insertion", [](const Problem& problem, unsigned) {
+             return pathCost(cheapestInsertion(problem.matrix), problem.matrix);
+         }},
+        {"insertion+2opt", [](const Problem& problem, unsigned) {
+             vector<int> path = cheapestInsertion(problem.matrix);
+             return improvePath(path, problem, LocalSearchMethod::TwoOpt);
+         }},
+        {"grasp-3opt", graspWith(LocalSearchMethod::ThreeOpt)},
+        {"grasp-oropt", graspWith(LocalSearchMethod::OrOpt)},
+        {"grasp-lk", graspWith(LocalSearchMethod::LinKernighan)},
+    };
+}
+
+// Percentil pelo posto mais próximo (valores ordenados)
+double percentile(const vector<double>& sorted, double fraction) {
+    size_t rank = static_cast<size_t>(ceil(fraction * sorted.size()));
+    return sorted[min(sorted.size(), max<size_t>(rank, 1)) - 1];
+}
+
+double median(const vector<double>& sorted) {
+    size_t n = sorted.size();
+    return n % 2 == 1 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+}
+
+// Lê os ótimos de referência: linhas "Problema,Modo,Otimo" (com cabeçalho)
+map<pair<int, string>, double> loadOptima(const string& filePath) {
+    map<pair<int, string>, double> optima;
+    ifstream file(filePath);
+    if (!file.is_open()) {
+        cerr << "Erro ao abrir o arquivo: " << filePath << endl;
+        return optima;
+    }
+    string line;
+    getline(file, line); // Cabeçalho
+    while (getline(file, line)) {
+        stringstream stream(line);
+        string problem, mode, value;
+        if (getline(stream, problem, ',') && getline(stream, mode, ',') && getline(stream, value)) {
+            optima[{atoi(problem.c_str()), mode}] = strtod(value.c_str(), nullptr);
+        }
+    }
+    return optima;
+}
+
+Result measure(const Problem& problem, const Algorithm& algorithm, const Options& options) {
+    // Aquecimento: caches, alocador e frequência do processador
+    for (int i = 0; i < options.warmup; ++i) {
+        algorithm.run(problem, options.seed + i);
+    }
+
+    vector<double> times, costs;
+    for (int i = 0; i < options.repetitions; ++i) {
+        auto start = steady_clock::now();
+        double cost = algorithm.run(problem, options.seed + i);
+        times.push_back(duration<double, milli>(steady_clock::now() - start).count());
+        costs.push_back(cost);
+    }
+    sort(times.begin(), times.end());
+    sort(costs.begin(), costs.end());
+
+    Result result;
+    result.problem = problem.number;
+    result.cities = static_cast<int>(problem.matrix.size());
+    result.mode = problem.mode;
+    result.algorithm = algorithm.name;
+    result.repetitions = options.repetitions;
+    result.minTime = times.front();
+    result.medianTime = median(times);
+    result.p95Time = percentile(times, 0.95);
+    result.minCost = costs.front();
+    result.medianCost = median(costs);
+    result.optimum = NAN;
+    result.gap = NAN;
+    result.lowerBound = problem.lowerBound;
+    result.boundGap = optimalityGap(result.minCost, problem.lowerBound);
+    return result;
+}
+
+// Número para JSON (null quando não há valor)
+string jsonNumber(double value) {
+    if (std::isnan(value)) return "null";
+    ostringstream stream;
+    stream << value;
+    return stream.str();
+}
+
+bool writeJson(const string& filePath, const vector<Result>& results, const Options& options) {
+    ofstream file(filePath);
+    if (!file.is_open()) {
+        cerr << "Erro ao abrir o arquivo: " << filePath << endl;
+        return false;
+    }
+    file << "{\n  \"repetitions\": " << options.repetitions << ",\n  \"warmup\": " << options.warmup
+         << ",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        file << "    {\"problem\": " << r.problem << ", \"cities\": " << r.cities << ", \"mode\": \"" << r.mode
+             << "\", \"algorithm\": \"" << r.algorithm << "\", \"time_ms\": {\"min\": " << jsonNumber(r.minTime)
+             << ", \"median\": " << jsonNumber(r.medianTime) << ", \"p95\": " << jsonNumber(r.p95Time)
+             << "}, \"cost\": {\"min\": " << jsonNumber(r.minCost) << ", \"median\": " << jsonNumber(r.medianCost)
+             << "}, \"optimum\": " << jsonNumber(r.optimum) << ", \"gap_percent\": " << jsonNumber(r.gap)
+             << ", \"lower_bound\": " << jsonNumber(r.lowerBound) << ", \"bound_gap_percent\": " << jsonNumber(r.boundGap)
+             << "}"
+             << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+    return true;
+}
+
+bool writeCsv(const string& filePath, const vector<Result>& results) {
+    ofstream file(filePath);
+    if (!file.is_open()) {
+        cerr << "Erro ao abrir o arquivo: " << filePath << endl;
+        return false;
+    }
+    file << "Problema,Cidades,Modo,Algoritmo,Repeticoes,Tempo min (ms),Tempo mediana (ms),Tempo p95 (ms),"
+            "Custo min,Custo mediana,Otimo,Gap (%),Limite inferior,Gap limite (%)\n";
+    for (const Result& r : results) {
+        file << r.problem << "," << r.cities << "," << r.mode << "," << r.algorithm << "," << r.repetitions << ","
+             << r.minTime << "," << r.medianTime << "," << r.p95Time << "," << r.minCost << "," << r.medianCost << ","
+             << (std::isnan(r.optimum) ? "" : to_string(r.optimum)) << ","
+             << (std::isnan(r.gap) ? "" : to_string(r.gap)) << "," << r.lowerBound << ","
+             << (std::isnan(r.boundGap) ? "" : to_string(r.boundGap)) << "\n";
+    }
+    return true;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (argument == "--repetitions" && hasValue) {
+            options.repetitions = max(1, atoi(argv[++i]));
+        } else if (argument == "--warmup" && hasValue) {
+            options.warmup = max(0, atoi(argv[++i]));
+        } else if (argument == "--iterations" && hasValue) {
+            options.graspIterations = max(1, atoi(argv[++i]));
+        } else if (argument == "--seed" && hasValue) {
+            options.seed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+        } else if (argument == "--optima" && hasValue) {
+            options.optimaFile = argv[++i];
+        } else if (argument == "--exact-memory" && hasValue) {
+            options.exactMemoryMb = strtoul(argv[++i], nullptr, 10);
+        } else if (argument == "--exact-time" && hasValue) {
+            options.exactTime = strtod(argv[++i], nullptr);
+        } else if (argument == "--json" && hasValue) {
+            options.jsonFile = argv[++i];
+        } else if (argument == "--csv" && hasValue) {
+            options.csvFile = argv[++i];
+        } else if (argument == "--distance-file" && hasValue) {
+            options.distanceFile = argv[++i];
+        } else if (argument == "--time-file" && hasValue) {
+            options.timeFile = argv[++i];
+        } else if (argument == "--algorithms" && hasValue) {
+            stringstream stream(argv[++i]);
+            string name;
+            while (getline(stream, name, ',')) {
+                if (!name.empty()) options.algorithms.push_back(name);
+            }
+        } else {
+            cerr << "Argumento desconhecido: " << argument << endl;
+            cerr << "Uso: " << argv[0] << " [--repetitions n] [--warmup n] [--iterations n] [--seed s]\n"
+                 << "       [--algorithms a,b,...] [--optima otimos.csv] [--json saida.json] [--csv saida.csv]\n"
+                 << "       [--distance-file Km.csv] [--time-file Min.csv] [--exact-memory MB] [--exact-time s]" << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Mede cada algoritmo nos 12 problemas do TCC (6 tamanhos x distância/tempo), com aquecimento
+// e repetições, e grava tempo mínimo, mediano e p95, custos e gap sobre os ótimos de referência
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    Matrix distanceMatrix = loadMatrix(options.distanceFile);
+    Matrix timeMatrix = loadMatrix(options.timeFile);
+    if (distanceMatrix.empty() || timeMatrix.empty()) {
+        cerr << "Erro: Dados não carregados corretamente." << endl;
+        return 1;
+    }
+
+    vector<Algorithm> algorithms;
+    for (const Algorithm& algorithm : makeAlgorithms(options)) {
+        if (options.algorithms.empty() ||
+            find(options.algorithms.begin(), options.algorithms.end(), algorithm.name) != options.algorithms.end()) {
+            algorithms.push_back(algorithm);
+        }
+    }
+    if (algorithms.empty()) {
+        cerr << "Nenhum algoritmo selecionado (use greedy, greedy+swap, insertion, insertion+2opt, grasp-3opt, "
+                "grasp-oropt ou grasp-lk)" << endl;
+        return 1;
+    }
+
+    map<pair<int, string>, double> optima;
+    if (!options.optimaFile.empty()) {
+        optima = loadOptima(options.optimaFile);
+    }
+
+    // Os mesmos tamanhos de Barata/Teste.cpp
+    vector<int> sizes = {48, 36, 24, 12, 7, 6};
+    vector<Problem> problems;
+    for (size_t k = 0; k < sizes.size(); ++k) {
+        size_t size = min<size_t>(sizes[k], distanceMatrix.size());
+        Matrix slicedDistance = distanceMatrix.slice(size);
+        Matrix slicedTime = timeMatrix.slice(min<size_t>(sizes[k], timeMatrix.size()));
+        problems.push_back({static_cast<int>(k + 1), "Distância", slicedDistance, NeighborLists(slicedDistance, 10),
+                            heldKarpBound(slicedDistance)});
+        problems.push_back({static_cast<int>(k + 1), "Tempo", slicedTime, NeighborLists(slicedTime, 10),
+                            heldKarpBound(slicedTime)});
+    }
+
+    // Ótimos que faltam no CSV, pelo Held-Karp nos problemas que cabem na memória permitida
+    for (const Problem& problem : problems) {
+        size_t bytes = heldKarpMemoryBytes(problem.matrix.size());
+        if (options.exactMemoryMb == 0 || optima.count({problem.number, problem.mode}) > 0 ||
+            bytes > options.exactMemoryMb << 20) {
+            continue;
+        }
+        double optimum = heldKarp(problem.matrix, defaultThreadCount(), bytes).second;
+        optima[{problem.number, problem.mode}] = optimum;
+        cout << "Ótimo (Held-Karp) do problema " << problem.number << " (" << problem.matrix.size() << ", "
+             << problem.mode << "): " << optimum << endl;
+    }
+    // Os demais pelo branch-and-bound a partir da rota do GRASP; sem a prova no prazo, não entram
+    for (const Problem& problem : problems) {
+        if (options.exactTime <= 0 || optima.count({problem.number, problem.mode}) > 0 ||
+            !problem.matrix.isSymmetric()) {
+            continue;
+        }
+        vector<int> incumbent = grasp(problem.matrix, options.graspIterations, 0.3, LocalSearchMethod::ThreeOpt, 1,
+                                      options.seed, &problem.neighbors)
+                                    .first;
+        Deadline deadline(options.exactTime);
+        BranchAndBoundResult exact = branchAndBound(problem.matrix, incumbent, defaultThreadCount(), &deadline);
+        cout << "Branch-and-bound do problema " << problem.number << " (" << problem.matrix.size() << ", "
+             << problem.mode << "): " << exact.cost << " | limite " << exact.lowerBound << " | nós " << exact.nodes
+             << (exact.optimal ? " | ótimo" : " | prazo esgotado") << endl;
+        if (exact.optimal) optima[{problem.number, problem.mode}] = exact.cost;
+    }
+
+    cout << "Repetições: " << options.repetitions << " | Aquecimento: " << options.warmup << endl;
+    vector<Result> results;
+    for (const Problem& problem : problems) {
+        for (const Algorithm& algorithm : algorithms) {
+            Result result = measure(problem, algorithm, options);
+            auto optimum = optima.find({problem.number, problem.mode});
+            if (optimum != optima.end() && optimum->second > 0) {
+                result.optimum = optimum->second;
+                result.gap = (result.minCost - result.optimum) / result.optimum * 100;
+            }
+            cout << "Problema " << result.problem << " (" << result.cities << ", " << result.mode << ") "
+                 << result.algorithm << ": tempo min " << result.minTime << " ms | mediana " << result.medianTime
+                 << " ms | p95 " << result.p95Time << " ms | custo " << result.minCost;
+            if (!std::isnan(result.gap)) cout << " | gap " << result.gap << "%";
+            cout << " | limite " << result.lowerBound << " (gap " << result.boundGap << "%)";
+            cout << endl;
+            results.push_back(result);
+        }
+    }
+
+    bool written = writeJson(options.jsonFile, results, options);
+    written = writeCsv(options.csvFile, results) && written;
+    return written ? 0 : 1;
+}
@@ -0,0 +1,199 @@
+#ifndef COMMON_BINARYMATRIX_HPP
+#define COMMON_BINARYMATRIX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "CostMatrix.hpp"
+#include "CsvLoader.hpp"
+#include "MappedFile.hpp"
+
+// Formato binário de instância (.bin):
+//   cabeçalho de 64 bytes (BinaryMatrixHeader) seguido dos elementos crus da matriz,
+//   linha a linha sem preenchimento: n*n elementos no modo completo ou, no modo simétrico,
+//   o triângulo superior com a diagonal (n*(n+1)/2 elementos).
+// Os valores são gravados na ordem de bytes da máquina; byteOrder detecta arquivos de
+// máquinas com ordem diferente.
+
+enum class MatrixElementType : std::uint32_t { Float32 = 1, Float64 = 2, Int32 = 3 };
+
+constexpr std::uint32_t BINARY_MATRIX_VERSION = 1;
+constexpr std::uint32_t BINARY_MATRIX_BYTE_ORDER = 0x01020304;
+constexpr std::uint32_t BINARY_MATRIX_SYMMETRIC = 1;
+
+struct BinaryMatrixHeader {
+    char magic[8];             // "TSPMATRX"
+    std::uint32_t version;     // BINARY_MATRIX_VERSION
+    std::uint32_t byteOrder;   // BINARY_MATRIX_BYTE_ORDER
+    std::uint32_t elementType; // MatrixElementType
+    std::uint32_t flags;       // BINARY_MATRIX_SYMMETRIC
+    std::uint64_t n;           // Número de cidades
+    std::uint64_t dataOffset;  // Início dos elementos (alinhado em 64 bytes)
+    std::uint8_t reserved[24];
+};
+static_assert(sizeof(BinaryMatrixHeader) == 64, "o cabeçalho binário deve ter 64 bytes");
+
+template <typename T>
+constexpr MatrixElementType matrixElementType();
+template <>
+constexpr MatrixElementType matrixElementType<float>() { return MatrixElementType::Float32; }
+template <>
+constexpr MatrixElementType matrixElementType<double>() { return MatrixElementType::Float64; }
+template <>
+constexpr MatrixElementType matrixElementType<std::int32_t>() { return MatrixElementType::Int32; }
+
+inline std::size_t matrixElementSize(std::uint32_t elementType) {
+    switch (static_cast<MatrixElementType>(elementType)) {
+        case MatrixElementType::Float32: return sizeof(float);
+        case MatrixElementType::Float64: return sizeof(double);
+        case MatrixElementType::Int32: return sizeof(std::int32_t);
+    }
+    return 0;
+}
+
+// Caminho do arquivo binário correspondente a um CSV (troca a extensão por .bin)
+inline std::string binaryPathFor(const std::string& csvPath) {
+    return std::filesystem::path(csvPath).replace_extension(".bin").string();
+}
+
+// Grava a matriz no formato binário; com symmetric = true grava só o triângulo superior
+template <typename T>
+bool saveMatrixToBinary(const CostMatrix<T>& matrix, const std::string& filePath, bool symmetric) {
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Erro ao criar o arquivo: " << filePath << std::endl;
+        return false;
+    }
+
+    BinaryMatrixHeader header{};
+    std::memcpy(header.magic, "TSPMATRX", sizeof(header.magic));
+    header.version = BINARY_MATRIX_VERSION;
+    header.byteOrder = BINARY_MATRIX_BYTE_ORDER;
+    header.elementType = static_cast<std::uint32_t>(matrixElementType<T>());
+    header.flags = symmetric ? BINARY_MATRIX_SYMMETRIC : 0;
+    header.n = matrix.size();
+    header.dataOffset = sizeof(BinaryMatrixHeader);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::size_t n = matrix.size();
+    std::vector<T> row(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        std::size_t first = symmetric ? i : 0;
+        for (std::size_t j = first; j < n; ++j) {
+            row[j - first] = matrix(i, j);
+        }
+        file.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>((n - first) * sizeof(T)));
+    }
+
+    if (!file.good()) {
+        std::cerr << "Erro ao gravar o arquivo: " << filePath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Copia count elementos do tipo gravado no arquivo para o destino, convertendo se necessário
+template <typename T>
+void copyMatrixElements(const char* source, std::uint32_t elementType, T* destination, std::size_t count) {
+    if (static_cast<MatrixElementType>(elementType) == matrixElementType<T>()) {
+        std::memcpy(destination, source, count * sizeof(T));
+        return;
+    }
+    for (std::size_t k = 0; k < count; ++k) {
+        switch (static_cast<MatrixElementType>(elementType)) {
+            case MatrixElementType::Float32: {
+                float value;
+                std::memcpy(&value, source + k * sizeof(value), sizeof(value));
+                destination[k] = static_cast<T>(value);
+                break;
+            }
+            case MatrixElementType::Float64: {
+                double value;
+                std::memcpy(&value, source + k * sizeof(value), sizeof(value));
+                destination[k] = static_cast<T>(value);
+                break;
+            }
+            case MatrixElementType::Int32: {
+                std::int32_t value;
+                std::memcpy(&value, source + k * sizeof(value), sizeof(value));
+                destination[k] = static_cast<T>(value);
+                break;
+            }
+        }
+    }
+}
+
+// Carrega uma matriz binária mapeando o arquivo em memória: sem nenhuma interpretação de
+// texto, os elementos são copiados direto para a matriz (convertidos só se o tipo gravado
+// for diferente de T). Matrizes gravadas como simétricas são carregadas no modo simétrico.
+template <typename T = COST_TYPE>
+CostMatrix<T> loadMatrixFromBinary(const std::string& filePath) {
+    MappedFile file(filePath);
+    if (!file.isOpen()) {
+        std::cerr << "Erro ao abrir o arquivo: " << filePath << std::endl;
+        return CostMatrix<T>();
+    }
+
+    BinaryMatrixHeader header;
+    if (file.size() < sizeof(header)) {
+        std::cerr << "Erro: O arquivo " << filePath << " não é uma matriz binária válida." << std::endl;
+        return CostMatrix<T>();
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    std::size_t elementSize = matrixElementSize(header.elementType);
+    if (std::memcmp(header.magic, "TSPMATRX", sizeof(header.magic)) != 0 || header.version != BINARY_MATRIX_VERSION ||
+        elementSize == 0) {
+        std::cerr << "Erro: O arquivo " << filePath << " não é uma matriz binária válida." << std::endl;
+        return CostMatrix<T>();
+    }
+    if (header.byteOrder != BINARY_MATRIX_BYTE_ORDER) {
+        std::cerr << "Erro: O arquivo " << filePath << " foi gravado com outra ordem de bytes." << std::endl;
+        return CostMatrix<T>();
+    }
+
+    std::size_t n = static_cast<std::size_t>(header.n);
+    bool symmetric = (header.flags & BINARY_MATRIX_SYMMETRIC) != 0;
+    std::size_t count = symmetric ? n * (n + 1) / 2 : n * n;
+    if (header.dataOffset > file.size() || (file.size() - header.dataOffset) / elementSize < count) {
+        std::cerr << "Erro: O arquivo " << filePath << " está truncado." << std::endl;
+        return CostMatrix<T>();
+    }
+
+    const char* data = file.data() + header.dataOffset;
+    CostMatrix<T> matrix(n, symmetric);
+    if (symmetric) {
+        // O triângulo superior tem a mesma disposição na matriz e no arquivo
+        copyMatrixElements(data, header.elementType, matrix.data(), count);
+    } else {
+        for (std::size_t i = 0; i < n; ++i) {
+            copyMatrixElements(data + i * n * elementSize, header.elementType, matrix.row(i), n);
+        }
+    }
+    return matrix;
+}
+
+// Carrega a matriz de custos de um CSV, usando no lugar dele o arquivo .bin de mesmo nome
+// quando este existir e for mais novo que o CSV
+template <typename T = COST_TYPE>
+CostMatrix<T> loadMatrix(const std::string& csvPath) {
+    std::string binaryPath = binaryPathFor(csvPath);
+    std::error_code error;
+    auto binaryTime = std::filesystem::last_write_time(binaryPath, error);
+    if (!error) {
+        auto csvTime = std::filesystem::last_write_time(csvPath, error);
+        if (error || binaryTime >= csvTime) {
+            CostMatrix<T> matrix = loadMatrixFromBinary<T>(binaryPath);
+            if (!matrix.empty()) return matrix;
+        }
+    }
+    return loadMatrixFromCSV<T>(csvPath);
+}
+
+#endif
@@ -0,0 +1,252 @@
+#ifndef COMMON_BRANCHANDBOUND_HPP
+#define COMMON_BRANCHANDBOUND_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+#include "CostMatrix.hpp"
+#include "Deadline.hpp"
+#include "LocalSearch.hpp"
+#include "OneTree.hpp"
+#include "Parallel.hpp"
+
+// Iterações do subgradiente na raiz e em cada nó filho (que parte das penalidades do pai)
+constexpr int BRANCH_AND_BOUND_ROOT_ITERATIONS = 1000;
+constexpr int BRANCH_AND_BOUND_NODE_ITERATIONS = 50;
+
+struct BranchAndBoundResult {
+    std::vector<int> route;  // Caminho fechado a partir da cidade 0
+    double cost = std::numeric_limits<double>::infinity();
+    double lowerBound = 0.0; // Limite da raiz (ou o próprio custo, se a otimalidade foi provada)
+    std::size_t nodes = 0;   // Nós avaliados
+    bool optimal = false;    // false se o prazo acabou antes de a árvore ser esgotada
+};
+
+// Maior passo (1, 0.1, 0.01, ...) de que todos os custos são múltiplos, ou 0 se nenhum for.
+// Com custos múltiplos de d, uma rota melhor que a incumbente custa ao menos d a menos, o que
+// permite podar nós cujo limite passa de incumbente - d.
+template <typename T>
+double costResolution(const CostMatrix<T>& costMatrix) {
+    for (double resolution = 1.0; resolution >= 1e-4; resolution /= 10.0) {
+        bool multiple = true;
+        for (std::size_t i = 0; i < costMatrix.size() && multiple; ++i) {
+            for (std::size_t j = 0; j < costMatrix.size(); ++j) {
+                double units = costMatrix(i, j) / resolution;
+                if (std::abs(units - std::round(units)) > 1e-6) {
+                    multiple = false;
+                    break;
+                }
+            }
+        }
+        if (multiple) return resolution;
+    }
+    return 0.0;
+}
+
+// Fixa as consequências das arestas obrigatórias e proibidas de um nó: uma cidade com duas
+// obrigatórias perde as demais, uma cidade com só duas permitidas precisa delas, e o caminho
+// de obrigatórias não pode ser fechado antes de passar por todas as cidades. Devolve false se
+// o nó não admite rota.
+inline bool propagateEdges(std::vector<EdgeState>& states, std::size_t n) {
+    auto set = [&](std::size_t i, std::size_t j, EdgeState state) { states[i * n + j] = states[j * n + i] = state; };
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (std::size_t v = 0; v < n; ++v) {
+            int required = 0, allowed = 0;
+            for (std::size_t u = 0; u < n; ++u) {
+                if (u == v || states[v * n + u] == EdgeState::Forbidden) continue;
+                ++allowed;
+                required += states[v * n + u] == EdgeState::Required;
+            }
+            if (required > 2 || allowed < 2) return false;
+            if ((required == 2 && allowed > 2) || (allowed == 2 && required < 2)) {
+                EdgeState fixed = required == 2 ? EdgeState::Forbidden : EdgeState::Required;
+                for (std::size_t u = 0; u < n; ++u) {
+                    if (u != v && states[v * n + u] == EdgeState::Free) set(v, u, fixed);
+                }
+                changed = true;
+            }
+        }
+        if (changed) continue;
+
+        // Percorre cada caminho de obrigatórias a partir de uma ponta e proíbe fechá-lo
+        std::vector<std::vector<int>> adjacent(n);
+        for (std::size_t v = 0; v < n; ++v) {
+            for (std::size_t u = v + 1; u < n; ++u) {
+                if (states[v * n + u] == EdgeState::Required) {
+                    adjacent[v].push_back(static_cast<int>(u));
+                    adjacent[u].push_back(static_cast<int>(v));
+                }
+            }
+        }
+        std::vector<char> visited(n, 0);
+        for (std::size_t start = 0; start < n; ++start) {
+            if (adjacent[start].size() != 1 || visited[start]) continue;
+            int previous = -1, city = static_cast<int>(start);
+            std::size_t length = 1;
+            visited[start] = 1;
+            while (true) {
+                int next = -1;
+                for (int u : adjacent[city]) {
+                    if (u != previous) next = u;
+                }
+                if (next < 0) break;
+                previous = city;
+                city = next;
+                visited[city] = 1;
+                ++length;
+            }
+            if (length < n && states[start * n + city] == EdgeState::Free) {
+                set(start, city, EdgeState::Forbidden);
+                changed = true;
+            }
+        }
+        // Sobram as cidades em ciclos de obrigatórias: só vale o ciclo que passa por todas
+        for (std::size_t v = 0; v < n; ++v) {
+            if (visited[v] || adjacent[v].size() != 2) continue;
+            int previous = static_cast<int>(v), city = adjacent[v][0];
+            std::size_t length = 1;
+            while (city != static_cast<int>(v)) {
+                visited[city] = 1;
+                int next = adjacent[city][0] == previous ? adjacent[city][1] : adjacent[city][0];
+                previous = city;
+                city = next;
+                ++length;
+            }
+            if (length < n) return false;
+        }
+    }
+    return true;
+}
+
+// Branch-and-bound exato para matrizes simétricas. O limite de cada nó é o de Held e Karp
+// (1-árvore com penalidades otimizadas por subgradiente, OneTreeBound); os filhos herdam as
+// penalidades do pai. A ramificação escolhe a cidade de maior grau da 1-árvore e uma aresta
+// livre dela na árvore: um filho proíbe a aresta, o outro a torna obrigatória. A busca é em
+// profundidade, começa com a incumbente recebida (uma rota do GRASP, por exemplo) e divide as
+// subárvores entre as threads com roubo de trabalho (parallelExplore). O prazo vale também para
+// o subgradiente da raiz e de cada nó; ao fim dele devolve a melhor rota encontrada, sem a prova
+// de otimalidade (e com limite menos infinito se não houve tempo nem para a raiz).
+template <typename T>
+BranchAndBoundResult branchAndBound(const CostMatrix<T>& costMatrix, const std::vector<int>& incumbent,
+                                    int numThreads = 1, const Deadline* deadline = nullptr) {
+    BranchAndBoundResult result;
+    std::size_t n = costMatrix.size();
+    if (n < 4) {
+        // Com até 3 cidades toda rota tem o mesmo custo em matrizes simétricas
+        result.route.resize(n);
+        std::iota(result.route.begin(), result.route.end(), 0);
+        result.cost = n > 0 ? cycleCost(result.route, costMatrix) : 0.0;
+        result.route.push_back(0);
+        result.lowerBound = result.cost;
+        result.optimal = true;
+        return result;
+    }
+
+    std::vector<int> bestRoute = incumbent;
+    if (bestRoute.size() == n + 1) bestRoute.pop_back();
+    if (bestRoute.size() != n) {
+        bestRoute.resize(n);
+        std::iota(bestRoute.begin(), bestRoute.end(), 0);
+    }
+    std::atomic<double> upperBound(cycleCost(bestRoute, costMatrix));
+    std::mutex incumbentMutex;
+
+    // Poda: um nó só interessa se puder ter rota menor que a incumbente em ao menos um passo
+    double resolution = costResolution(costMatrix);
+    double margin = resolution > 0 ? resolution * (1.0 - 1e-3) : IMPROVEMENT_EPSILON;
+    auto pruneAbove = [&]() { return upperBound.load() - margin; };
+
+    struct Node {
+        std::vector<EdgeState> states;
+        std::vector<double> pi;
+        double bound = 0.0;  // Limite do pai (poda o nó se a incumbente melhorou desde então)
+        int depth = 0;
+    };
+
+    Node root;
+    root.states.assign(n * n, EdgeState::Free);
+    for (std::size_t v = 0; v < n; ++v) root.states[v * n + v] = EdgeState::Forbidden;
+    root.pi.assign(n, 0.0);
+    OneTreeBound<T> rootBound(costMatrix);
+    root.bound = rootBound.ascend(root.pi, upperBound.load(), BRANCH_AND_BOUND_ROOT_ITERATIONS, &root.states,
+                                  std::numeric_limits<double>::infinity(), deadline);
+    result.lowerBound = root.bound;
+
+    std::vector<OneTreeBound<T>> bounds(std::max(1, numThreads), OneTreeBound<T>(costMatrix));
+    std::atomic<std::size_t> nodes(0);
+    std::atomic<bool> stopped(false);
+
+    parallelExplore(std::vector<Node>{root}, numThreads, [&](Node& node, int threadId, auto push) {
+        if (stopped.load() || node.bound > pruneAbove()) return;
+        if (expired(deadline)) {
+            stopped.store(true);
+            return;
+        }
+        nodes.fetch_add(1);
+
+        OneTreeBound<T>& bound = bounds[threadId];
+        // As penalidades da raiz já foram otimizadas: basta refazer a árvore delas
+        int iterations = node.depth == 0 ? 1 : BRANCH_AND_BOUND_NODE_ITERATIONS;
+        double lower = bound.ascend(node.pi, upperBound.load(), iterations, &node.states, pruneAbove(), deadline);
+        if (expired(deadline)) {
+            // A subida pode ter parado no prazo: o nó não foi resolvido
+            stopped.store(true);
+            return;
+        }
+        if (std::isinf(lower) || lower > pruneAbove()) return;
+
+        if (bound.isTour()) {
+            std::vector<int> route = bound.tour();
+            double cost = cycleCost(route, costMatrix);
+            std::lock_guard<std::mutex> lock(incumbentMutex);
+            if (cost < upperBound.load()) {
+                upperBound.store(cost);
+                bestRoute = route;
+            }
+            return;
+        }
+
+        // Cidade de maior grau e a aresta livre mais cara dela na 1-árvore
+        const std::vector<int>& degree = bound.degree();
+        int city = static_cast<int>(std::max_element(degree.begin(), degree.end()) - degree.begin());
+        int branchTo = -1;
+        double branchWeight = -std::numeric_limits<double>::infinity();
+        for (const auto& edge : bound.edges()) {
+            if (edge.first != city && edge.second != city) continue;
+            int other = edge.first == city ? edge.second : edge.first;
+            if (node.states[city * n + other] != EdgeState::Free) continue;
+            double w = bound.weight(city, other) + node.pi[city] + node.pi[other];
+            if (w > branchWeight) {
+                branchWeight = w;
+                branchTo = other;
+            }
+        }
+        if (branchTo < 0) return;
+
+        // O filho que proíbe a aresta sai da fila primeiro (a árvore queria um grau menor ali)
+        for (EdgeState state : {EdgeState::Required, EdgeState::Forbidden}) {
+            Node child{node.states, node.pi, lower, node.depth + 1};
+            child.states[city * n + branchTo] = child.states[branchTo * n + city] = state;
+            if (propagateEdges(child.states, n)) push(std::move(child));
+        }
+    });
+
+    result.nodes = nodes.load();
+    result.optimal = !stopped.load();
+    std::rotate(bestRoute.begin(), std::find(bestRoute.begin(), bestRoute.end(), 0), bestRoute.end());
+    result.cost = cycleCost(bestRoute, costMatrix);
+    bestRoute.push_back(0);
+    result.route = bestRoute;
+    if (result.optimal) result.lowerBound = result.cost;
+    return result;
+}
+
+#endif
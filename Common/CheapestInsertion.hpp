@@ -0,0 +1,132 @@
+#ifndef COMMON_CHEAPESTINSERTION_HPP
+#define COMMON_CHEAPESTINSERTION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "CostMatrix.hpp"
+
+// Inserção mais barata a partir da rota 0 -> 1 -> 0.
+// A rota é uma lista ligada (sucessor de cada cidade), então inserir é O(1). Para cada cidade
+// fora da rota guarda-se a aresta (p, succ(p)) onde inseri-la custa menos, e um heap de mínimo
+// ordena as cidades por esse acréscimo. Depois de inserir x entre p e q, só as duas arestas
+// novas (p, x) e (x, q) são testadas para cada cidade; só as cidades cuja melhor aresta era a
+// (p, q) removida precisam varrer a rota de novo. Entradas antigas do heap são descartadas ao
+// sair (o acréscimo não bate mais com o da cidade). Custo típico O(n^2 log n).
+// Empates são resolvidos como na varredura completa: menor cidade e, para a mesma cidade, a
+// aresta que aparece primeiro na rota (comparada por rótulos de ordem crescentes ao longo da
+// lista, refeitos quando não há mais espaço entre dois vizinhos).
+// Devolve o caminho fechado, começando e terminando na cidade 0.
+template <typename T>
+std::vector<int> cheapestInsertion(const CostMatrix<T>& costMatrix) {
+    int n = static_cast<int>(costMatrix.size());
+    if (n == 0) return {};
+    if (n == 1) return {0, 0};
+
+    std::vector<int> successor(n, -1);
+    successor[0] = 1;
+    successor[1] = 0;
+    std::vector<char> routed(n, 0);
+    routed[0] = routed[1] = 1;
+
+    // Rótulos crescentes ao longo da rota a partir da cidade 0 (o fim da rota vale END_LABEL)
+    constexpr std::uint64_t END_LABEL = std::uint64_t(1) << 62;
+    std::vector<std::uint64_t> label(n, 0);
+    label[1] = END_LABEL / 2;
+    auto relabel = [&](int count) {
+        std::uint64_t gap = END_LABEL / (count + 1);
+        int city = 0;
+        for (int k = 0; k < count; ++k, city = successor[city]) {
+            label[city] = gap * k;
+        }
+    };
+
+    // Melhor aresta de inserção de cada cidade: (bestFrom[c], successor[bestFrom[c]])
+    std::vector<int> bestFrom(n, -1);
+    std::vector<double> bestIncrease(n, std::numeric_limits<double>::infinity());
+
+    using Entry = std::pair<double, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+
+    auto increase = [&](int p, int city) {
+        int q = successor[p];
+        return static_cast<double>(costMatrix(p, city)) + costMatrix(city, q) - costMatrix(p, q);
+    };
+
+    // Percorre a rota inteira a partir da cidade 0 procurando a melhor aresta para a cidade
+    auto rescan = [&](int city) {
+        bestIncrease[city] = std::numeric_limits<double>::infinity();
+        int p = 0;
+        do {
+            double value = increase(p, city);
+            if (value < bestIncrease[city]) {
+                bestIncrease[city] = value;
+                bestFrom[city] = p;
+            }
+            p = successor[p];
+        } while (p != 0);
+        heap.emplace(bestIncrease[city], city);
+    };
+
+    for (int city = 2; city < n; ++city) {
+        rescan(city);
+    }
+
+    for (int inserted = 2; inserted < n; ++inserted) {
+        // Cidade de menor acréscimo, ignorando as entradas antigas
+        int x = -1;
+        while (x < 0) {
+            auto [value, city] = heap.top();
+            heap.pop();
+            if (!routed[city] && value == bestIncrease[city]) x = city;
+        }
+
+        int p = bestFrom[x];
+        int q = successor[p];
+        successor[x] = q;
+        successor[p] = x;
+        routed[x] = 1;
+        std::uint64_t nextLabel = q == 0 ? END_LABEL : label[q];
+        if (nextLabel - label[p] < 2) {
+            relabel(inserted + 1);
+        } else {
+            label[x] = label[p] + (nextLabel - label[p]) / 2;
+        }
+
+        for (int city = 0; city < n; ++city) {
+            if (routed[city]) continue;
+            if (bestFrom[city] == p) {
+                // A melhor aresta da cidade era a (p, q), que deixou de existir
+                rescan(city);
+                continue;
+            }
+            for (int from : {p, x}) {
+                double value = increase(from, city);
+                if (value < bestIncrease[city]) {
+                    bestIncrease[city] = value;
+                    bestFrom[city] = from;
+                    heap.emplace(value, city);
+                } else if (value == bestIncrease[city] && label[from] < label[bestFrom[city]]) {
+                    bestFrom[city] = from;
+                }
+            }
+        }
+    }
+
+    std::vector<int> path;
+    path.reserve(n + 1);
+    int city = 0;
+    do {
+        path.push_back(city);
+        city = successor[city];
+    } while (city != 0);
+    path.push_back(0);
+    return path;
+}
+
+#endif
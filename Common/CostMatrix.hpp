@@ -0,0 +1,168 @@
+#ifndef COMMON_COSTMATRIX_HPP
+#define COMMON_COSTMATRIX_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Tipo dos elementos da matriz usada pelos programas (float, double ou int32_t).
+// Pode ser trocado na compilação, por exemplo: g++ -DCOST_TYPE=float ...
+#ifndef COST_TYPE
+#define COST_TYPE double
+#endif
+
+// Tamanho da linha de cache usado para alinhar e preencher as linhas da matriz
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+// Alocador que devolve memória alinhada em Align bytes
+template <typename T, std::size_t Align = CACHE_LINE_SIZE>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Align>;
+    };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align>&) noexcept {}
+
+    T* allocate(std::size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Align)));
+    }
+
+    void deallocate(T* pointer, std::size_t) noexcept {
+        ::operator delete(pointer, std::align_val_t(Align));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Align>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Align>&) const noexcept { return false; }
+};
+
+// Matriz de custos n x n em um único bloco contíguo (row-major).
+// No modo completo cada linha é preenchida até um múltiplo da linha de cache, então toda
+// linha começa alinhada. No modo simétrico só o triângulo superior (com a diagonal) é
+// guardado, usando cerca de metade da memória; (i, j) e (j, i) apontam para o mesmo elemento.
+template <typename T>
+class CostMatrix {
+public:
+    using value_type = T;
+
+    CostMatrix() = default;
+
+    CostMatrix(std::size_t n, bool symmetric = false, T value = T())
+        : n_(n), stride_(symmetric ? n : paddedStride(n)), symmetric_(symmetric),
+          data_(symmetric ? n * (n + 1) / 2 : n * paddedStride(n), value) {}
+
+    std::size_t size() const { return n_; }
+    bool empty() const { return n_ == 0; }
+    bool symmetric() const { return symmetric_; }
+
+    // Distância entre as linhas consecutivas no modo completo (em elementos)
+    std::size_t stride() const { return stride_; }
+
+    // Bytes ocupados pelos elementos da matriz
+    std::size_t memoryBytes() const { return data_.size() * sizeof(T); }
+
+    // O acesso não constante pode alterar a matriz e descarta a verificação de simetria guardada
+    T operator()(std::size_t i, std::size_t j) const { return data_[index(i, j)]; }
+    T& operator()(std::size_t i, std::size_t j) {
+        symmetryCache_.reset();
+        return data_[index(i, j)];
+    }
+
+    // Ponteiro para o início da linha i (apenas no modo completo)
+    const T* row(std::size_t i) const { return data_.data() + i * stride_; }
+    T* row(std::size_t i) {
+        symmetryCache_.reset();
+        return data_.data() + i * stride_;
+    }
+
+    const T* data() const { return data_.data(); }
+    T* data() {
+        symmetryCache_.reset();
+        return data_.data();
+    }
+
+    // Verifica se c(i, j) == c(j, i) para todos os pares. A verificação (O(n²)) é feita uma vez
+    // e guardada: as vizinhanças da busca local consultam a simetria a cada construção.
+    bool isSymmetric() const {
+        if (symmetric_) return true;
+        signed char cached = symmetryCache_.value.load(std::memory_order_relaxed);
+        if (cached >= 0) return cached == 1;
+        bool result = true;
+        for (std::size_t i = 0; i < n_ && result; ++i) {
+            for (std::size_t j = i + 1; j < n_; ++j) {
+                if ((*this)(i, j) != (*this)(j, i)) {
+                    result = false;
+                    break;
+                }
+            }
+        }
+        symmetryCache_.value.store(result ? 1 : 0, std::memory_order_relaxed);
+        return result;
+    }
+
+    // Devolve uma cópia no modo simétrico (triângulo superior); só faz sentido se isSymmetric()
+    CostMatrix compacted() const {
+        CostMatrix result(n_, true);
+        for (std::size_t i = 0; i < n_; ++i) {
+            for (std::size_t j = i; j < n_; ++j) {
+                result(i, j) = (*this)(i, j);
+            }
+        }
+        return result;
+    }
+
+    // Devolve a submatriz das primeiras size cidades, no mesmo modo de armazenamento
+    CostMatrix slice(std::size_t size) const {
+        CostMatrix result(size, symmetric_);
+        for (std::size_t i = 0; i < size; ++i) {
+            for (std::size_t j = symmetric_ ? i : 0; j < size; ++j) {
+                result(i, j) = (*this)(i, j);
+            }
+        }
+        return result;
+    }
+
+private:
+    // Resultado de isSymmetric() (-1: ainda não verificado). Atômico porque várias threads podem
+    // consultar a mesma matriz; a cópia leva o valor junto.
+    struct SymmetryCache {
+        std::atomic<signed char> value{-1};
+
+        SymmetryCache() = default;
+        SymmetryCache(const SymmetryCache& other) noexcept : value(other.value.load(std::memory_order_relaxed)) {}
+        SymmetryCache& operator=(const SymmetryCache& other) noexcept {
+            value.store(other.value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
+        void reset() { value.store(-1, std::memory_order_relaxed); }
+    };
+
+    static std::size_t paddedStride(std::size_t n) {
+        constexpr std::size_t perLine = CACHE_LINE_SIZE / sizeof(T) > 0 ? CACHE_LINE_SIZE / sizeof(T) : 1;
+        return (n + perLine - 1) / perLine * perLine;
+    }
+
+    std::size_t index(std::size_t i, std::size_t j) const {
+        if (!symmetric_) return i * stride_ + j;
+        if (i > j) std::swap(i, j);
+        // Linhas 0..i-1 do triângulo superior ocupam i*n - i*(i-1)/2 elementos
+        return i * n_ - i * (i - 1) / 2 + (j - i);
+    }
+
+    std::size_t n_ = 0;
+    std::size_t stride_ = 0;
+    bool symmetric_ = false;
+    std::vector<T, AlignedAllocator<T>> data_;
+    mutable SymmetryCache symmetryCache_;
+};
+
+#endif
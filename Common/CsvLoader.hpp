@@ -0,0 +1,261 @@
+#ifndef COMMON_CSVLOADER_HPP
+#define COMMON_CSVLOADER_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "CostMatrix.hpp"
+#include "MappedFile.hpp"
+
+namespace csv_detail {
+
+// Resultado da leitura de uma célula
+enum class CellKind { Number, Empty, Text };
+
+inline double powerOfTen(int exponent) {
+    static const double table[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                   1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    if (exponent >= 0 && exponent <= 22) return table[exponent];
+    return std::pow(10.0, exponent);
+}
+
+inline bool isCellEnd(const char* p, const char* end) {
+    return p == end || *p == ',' || *p == '\n' || *p == '\r';
+}
+
+inline void skipSpaces(const char*& p, const char* end) {
+    while (p != end && (*p == ' ' || *p == '\t')) ++p;
+}
+
+// Avança p até o fim da célula atual (separador, fim de linha ou fim do arquivo)
+inline void skipCell(const char*& p, const char* end) {
+    bool quoted = false;
+    while (p != end) {
+        if (*p == '"') {
+            quoted = !quoted;
+        } else if (!quoted && (*p == ',' || *p == '\n' || *p == '\r')) {
+            return;
+        }
+        ++p;
+    }
+}
+
+// Lê uma célula numérica sem alocar. Dentro de aspas a vírgula é o separador decimal
+// ("38,8"); fora delas o separador é o ponto. Células vazias valem 0. Ao final, p fica
+// no separador que encerra a célula.
+inline CellKind scanCell(const char*& p, const char* end, double& value) {
+    value = 0;
+    skipSpaces(p, end);
+    if (isCellEnd(p, end)) return CellKind::Empty;
+
+    const char* start = p;
+    bool quoted = *p == '"';
+    if (quoted) ++p;
+    skipSpaces(p, end);
+
+    bool negative = false;
+    if (p != end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+
+    std::uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    while (p != end && *p >= '0' && *p <= '9') {
+        if (digits < 19) {
+            mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+            ++digits;
+        } else {
+            ++exponent; // Dígitos além da precisão de 64 bits só mudam a escala
+        }
+        ++p;
+    }
+    bool hasDigits = digits > 0;
+
+    if (p != end && (*p == '.' || (quoted && *p == ','))) {
+        ++p;
+        while (p != end && *p >= '0' && *p <= '9') {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+                ++digits;
+                --exponent;
+            }
+            hasDigits = true;
+            ++p;
+        }
+    }
+
+    if (hasDigits && p != end && (*p == 'e' || *p == 'E')) {
+        const char* exponentStart = p++;
+        bool negativeExponent = false;
+        if (p != end && (*p == '-' || *p == '+')) {
+            negativeExponent = *p == '-';
+            ++p;
+        }
+        if (p != end && *p >= '0' && *p <= '9') {
+            int explicitExponent = 0;
+            while (p != end && *p >= '0' && *p <= '9') {
+                if (explicitExponent < 10000) explicitExponent = explicitExponent * 10 + (*p - '0');
+                ++p;
+            }
+            exponent += negativeExponent ? -explicitExponent : explicitExponent;
+        } else {
+            p = exponentStart;
+        }
+    }
+
+    skipSpaces(p, end);
+    if (quoted) {
+        if (p == end || *p != '"') {
+            p = start;
+            skipCell(p, end);
+            return CellKind::Text;
+        }
+        ++p;
+        skipSpaces(p, end);
+    }
+
+    if (!isCellEnd(p, end)) {
+        p = start;
+        skipCell(p, end);
+        return CellKind::Text;
+    }
+    if (!hasDigits) {
+        // Só espaços ou aspas vazias ("")
+        return quoted ? CellKind::Empty : CellKind::Text;
+    }
+
+    double magnitude = static_cast<double>(mantissa);
+    value = exponent < 0 ? magnitude / powerOfTen(-exponent) : magnitude * powerOfTen(exponent);
+    if (negative) value = -value;
+    return CellKind::Number;
+}
+
+// Consome o separador da célula; retorna false quando a linha terminou
+inline bool nextCell(const char*& p, const char* end) {
+    if (p != end && *p == ',') {
+        ++p;
+        return true;
+    }
+    return false;
+}
+
+// Avança p até o início da próxima linha
+inline void nextLine(const char*& p, const char* end) {
+    while (p != end && *p != '\n') ++p;
+    if (p != end) ++p;
+}
+
+inline bool isBlankLine(const char* p, const char* end) {
+    skipSpaces(p, end);
+    return p == end || *p == '\n' || *p == '\r';
+}
+
+// Conta as células de uma linha e verifica se ela é um cabeçalho: contém texto ("Km") ou
+// é uma linha de índices (vazio, 1, 2, 3, ...)
+inline std::size_t inspectLine(const char* p, const char* end, bool& isHeader) {
+    std::size_t cells = 0;
+    bool hasText = false;
+    bool isIndexRow = true;
+    do {
+        double value;
+        CellKind kind = scanCell(p, end, value);
+        if (kind == CellKind::Text) hasText = true;
+        if (cells == 0) {
+            isIndexRow = isIndexRow && kind == CellKind::Empty;
+        } else {
+            isIndexRow = isIndexRow && kind == CellKind::Number && value == static_cast<double>(cells);
+        }
+        ++cells;
+    } while (nextCell(p, end));
+    isHeader = hasText || (isIndexRow && cells > 1);
+    return cells;
+}
+
+}  // namespace csv_detail
+
+// Carrega uma matriz de custos quadrada de um arquivo CSV mapeado em memória.
+// Aceita linha de cabeçalho ("Km,1,2,...") e coluna de rótulos, células vazias (tratadas como 0)
+// e valores com vírgula decimal entre aspas ("38,8"). Os valores são gravados diretamente
+// na matriz contígua. Em caso de erro, imprime a causa e devolve uma matriz vazia.
+template <typename T = COST_TYPE>
+CostMatrix<T> loadMatrixFromCSV(const std::string& filePath) {
+    using namespace csv_detail;
+
+    MappedFile file(filePath);
+    if (!file.isOpen()) {
+        std::cerr << "Erro ao abrir o arquivo: " << filePath << std::endl;
+        return CostMatrix<T>();
+    }
+
+    const char* p = file.data();
+    const char* end = p + file.size();
+    // Ignora o BOM UTF-8, se houver
+    if (end - p >= 3 && std::memcmp(p, "\xEF\xBB\xBF", 3) == 0) p += 3;
+
+    while (p != end && isBlankLine(p, end)) nextLine(p, end);
+    if (p == end) {
+        std::cerr << "Erro: O arquivo " << filePath << " está vazio." << std::endl;
+        return CostMatrix<T>();
+    }
+
+    bool isHeader;
+    std::size_t columns = inspectLine(p, end, isHeader);
+    if (isHeader) {
+        nextLine(p, end);
+        while (p != end && isBlankLine(p, end)) nextLine(p, end);
+        bool ignored;
+        columns = p != end ? inspectLine(p, end, ignored) : 0;
+    }
+
+    // Conta as linhas de dados não vazias
+    std::size_t rows = 0;
+    for (const char* line = p; line != end;) {
+        if (!isBlankLine(line, end)) ++rows;
+        const char* newline = static_cast<const char*>(std::memchr(line, '\n', static_cast<std::size_t>(end - line)));
+        line = newline ? newline + 1 : end;
+    }
+
+    // Com uma coluna a mais que o número de linhas, a primeira coluna é de rótulos
+    bool hasLabelColumn = columns == rows + 1;
+    if (!hasLabelColumn && columns != rows) {
+        std::cerr << "Erro: O arquivo " << filePath << " não contém uma matriz quadrada (" << rows << " linhas, "
+                  << columns << " colunas)." << std::endl;
+        return CostMatrix<T>();
+    }
+
+    CostMatrix<T> matrix(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+        while (isBlankLine(p, end)) nextLine(p, end);
+        T* row = matrix.row(i);
+        if (hasLabelColumn) {
+            skipCell(p, end);
+            nextCell(p, end);
+        }
+        for (std::size_t j = 0; j < rows; ++j) {
+            double value;
+            CellKind kind = scanCell(p, end, value);
+            if (kind == CellKind::Text) {
+                std::cerr << "Erro: Valor inválido no arquivo " << filePath << " (linha " << i + 1 << ", coluna "
+                          << j + 1 << ")." << std::endl;
+                return CostMatrix<T>();
+            }
+            row[j] = static_cast<T>(value);
+            if (!nextCell(p, end) && j + 1 < rows) {
+                std::cerr << "Erro: Linha " << i + 1 << " do arquivo " << filePath << " tem menos de " << rows
+                          << " valores." << std::endl;
+                return CostMatrix<T>();
+            }
+        }
+        nextLine(p, end);
+    }
+
+    return matrix;
+}
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef COMMON_DEADLINE_HPP
+#define COMMON_DEADLINE_HPP
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Prazo de execução medido a partir da construção (relógio monotônico). Sem limite (padrão ou
+// seconds <= 0) nunca expira.
+class Deadline {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Deadline() : start_(Clock::now()), limited_(false) {}
+    explicit Deadline(double seconds) : start_(Clock::now()), limited_(seconds > 0) {
+        if (limited_) {
+            end_ = start_ + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+        }
+    }
+
+    bool limited() const { return limited_; }
+    bool expired() const { return limited_ && Clock::now() >= end_; }
+
+    // Segundos desde a construção
+    double elapsed() const { return std::chrono::duration<double>(Clock::now() - start_).count(); }
+
+private:
+    Clock::time_point start_;
+    Clock::time_point end_;
+    bool limited_;
+};
+
+// Ponteiro opcional: nullptr significa sem prazo
+inline bool expired(const Deadline* deadline) {
+    return deadline != nullptr && deadline->expired();
+}
+
+// Traço de convergência: (tempo, melhor custo) a cada melhora do melhor custo. Pode ser
+// alimentado por várias threads (acesso protegido por mutex).
+class ConvergenceTrace {
+public:
+    explicit ConvergenceTrace(const Deadline& clock) : clock_(clock) {}
+
+    // Registra o custo se ele melhora o último registrado
+    void record(double cost) {
+        double time = clock_.elapsed();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (cost < bestCost_) {
+            bestCost_ = cost;
+            points_.emplace_back(time, cost);
+        }
+    }
+
+    std::vector<std::pair<double, double>> points() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return points_;
+    }
+
+    // Grava o traço em CSV (tempo em segundos, melhor custo)
+    bool writeCsv(const std::string& filePath) const {
+        std::ofstream file(filePath);
+        if (!file.is_open()) {
+            std::cerr << "Erro ao abrir o arquivo: " << filePath << std::endl;
+            return false;
+        }
+        file << "tempo_s,melhor_custo\n";
+        for (const auto& point : points()) {
+            file << point.first << "," << point.second << "\n";
+        }
+        return true;
+    }
+
+private:
+    const Deadline& clock_;
+    mutable std::mutex mutex_;
+    double bestCost_ = std::numeric_limits<double>::infinity();
+    std::vector<std::pair<double, double>> points_;
+};
+
+#endif
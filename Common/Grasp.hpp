@@ -0,0 +1,239 @@
+#ifndef COMMON_GRASP_HPP
+#define COMMON_GRASP_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "CostMatrix.hpp"
+#include "Deadline.hpp"
+#include "LinKernighan.hpp"
+#include "LocalSearch.hpp"
+#include "NeighborLists.hpp"
+#include "PathRelinking.hpp"
+#include "RandomizedConstruction.hpp"
+#include "ReactiveAlpha.hpp"
+#include "TwoLevelRoute.hpp"
+
+// Busca local aplicada a cada solução construída pelo GRASP
+enum class LocalSearchMethod { TwoOpt, ThreeOpt, OrOpt, LinKernighan };
+
+// Aplica a busca local escolhida com a representação de rota Route (vetor ou lista de dois níveis)
+template <typename T, typename Route>
+void localSearchWith(std::vector<int>& route, const CostMatrix<T>& costMatrix, LocalSearchMethod method,
+                     const NeighborLists* neighbors, const Deadline* deadline, const std::vector<int>* startCities) {
+    switch (method) {
+        case LocalSearchMethod::TwoOpt: {
+            TwoOptNeighborhood<T, Route> twoOpt(costMatrix, neighbors);
+            runLocalSearch<Route>(route, {&twoOpt}, deadline, startCities);
+            break;
+        }
+        case LocalSearchMethod::ThreeOpt: {
+            // Cada trio é avaliado em O(1) e só a melhor reconexão é aplicada
+            ThreeOptNeighborhood<T, Route> threeOpt(costMatrix, neighbors);
+            runLocalSearch<Route>(route, {&threeOpt}, deadline, startCities);
+            break;
+        }
+        case LocalSearchMethod::OrOpt: {
+            // Segmentos de 1 a 3 cidades, nos dois sentidos
+            OrOptNeighborhood<T, Route> orOpt(costMatrix, neighbors);
+            runLocalSearch<Route>(route, {&orOpt}, deadline, startCities);
+            break;
+        }
+        case LocalSearchMethod::LinKernighan: {
+            // Cadeias de 2-opt de profundidade variável, seguidas de Or-opt para os movimentos de
+            // segmento que a cadeia não alcança
+            LinKernighanNeighborhood<T, Route> linKernighan(costMatrix, neighbors);
+            OrOptNeighborhood<T, Route> orOpt(costMatrix, neighbors);
+            runLocalSearch<Route>(route, {&linKernighan, &orOpt}, deadline, startCities);
+            break;
+        }
+    }
+}
+
+// Aplica na rota a busca local escolhida, pelo driver compartilhado com bits "não olhe".
+// Instâncias grandes usam a lista de dois níveis, em que inverter um trecho custa O(sqrt(n)).
+// Se o prazo expirar, a busca para e a rota fica com os movimentos aplicados até ali. Com
+// startCities, só essas cidades começam na fila do driver (reparo local depois de uma perturbação).
+template <typename T>
+void localSearch(std::vector<int>& route, const CostMatrix<T>& costMatrix, LocalSearchMethod method,
+                 const NeighborLists* neighbors = nullptr, const Deadline* deadline = nullptr,
+                 const std::vector<int>* startCities = nullptr) {
+    if (route.size() >= TWO_LEVEL_MIN_CITIES) {
+        localSearchWith<T, TwoLevelRoute>(route, costMatrix, method, neighbors, deadline, startCities);
+    } else {
+        localSearchWith<T, RouteState>(route, costMatrix, method, neighbors, deadline, startCities);
+    }
+}
+
+// Publica um custo no melhor custo global sem bloqueio (compare-and-swap)
+// Retorna true se o custo era o menor já publicado
+inline bool publishBestCost(std::atomic<double>& bestCost, double cost) {
+    double current = bestCost.load(std::memory_order_relaxed);
+    while (cost < current) {
+        if (bestCost.compare_exchange_weak(current, cost, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Função principal do algoritmo GRASP
+// As iterações são divididas entre numThreads threads; cada thread tem seu próprio gerador,
+// semeado a partir de (seed, índice da thread), então o resultado é reprodutível para a mesma
+// semente e o mesmo número de threads. rcl escolhe o critério da lista restrita da construção.
+// Com reactive (GRASP reativo), alpha é ignorado: cada thread sorteia alpha com uma cópia de
+// *reactive e, no fim, as estatísticas de todas as threads são somadas em *reactive.
+// Com religação de caminhos, cada ótimo local é religado a uma solução sorteada da elite (que
+// é compartilhada entre as threads), a melhor solução intermediária passa pela busca local e o
+// melhor dos dois resultados disputa uma vaga na elite. Com mais de uma thread a ordem de acesso
+// à elite varia, então o resultado deixa de ser reprodutível pela semente.
+// Com deadline, as threads param no prazo (interrompendo a busca local em andamento) e a melhor
+// rota encontrada até ali é devolvida; cada thread completa ao menos uma construção. Com
+// maxIterations <= 0 e um prazo, as iterações só terminam no prazo. trace recebe (tempo, custo)
+// a cada melhora do melhor custo global. As threads também param quando o melhor custo chega a
+// targetCost (por exemplo, o limite inferior mais a tolerância de gap).
+template <typename T>
+std::pair<std::vector<int>, double> grasp(const CostMatrix<T>& costMatrix, int maxIterations, double alpha,
+                                          LocalSearchMethod method, int numThreads = 1, unsigned seed = 0,
+                                          const NeighborLists* neighbors = nullptr,
+                                          const RclOptions& rcl = RclOptions(), ReactiveAlpha* reactive = nullptr,
+                                          const PathRelinkingOptions& relinking = PathRelinkingOptions(),
+                                          const Deadline* deadline = nullptr, ConvergenceTrace* trace = nullptr,
+                                          double targetCost = -std::numeric_limits<double>::infinity()) {
+    bool untilDeadline = maxIterations <= 0 && deadline != nullptr && deadline->limited();
+    if (untilDeadline) {
+        numThreads = std::max(1, numThreads);
+    } else {
+        maxIterations = std::max(1, maxIterations);
+        numThreads = std::max(1, std::min(numThreads, maxIterations));
+    }
+    ElitePool elite(relinking.eliteSize, static_cast<std::size_t>(relinking.minDistance * costMatrix.size()),
+                    costMatrix.isSymmetric());
+    std::vector<ReactiveAlpha> reactiveByThread;
+    if (reactive != nullptr && !reactive->stats().empty()) {
+        reactiveByThread.assign(numThreads, *reactive);
+        for (ReactiveAlpha& threadStats : reactiveByThread) {
+            threadStats.clearStats();
+        }
+    }
+
+    // Melhor rota de cada thread e melhor custo global publicado
+    std::vector<std::vector<int>> bestRoutes(numThreads);
+    std::vector<double> bestCosts(numThreads, std::numeric_limits<double>::infinity());
+    std::atomic<double> globalBestCost(std::numeric_limits<double>::infinity());
+
+    auto worker = [&](int threadId) {
+        std::seed_seq sequence{seed, static_cast<unsigned>(threadId)};
+        std::mt19937 generator(sequence);
+        GreedyRandomizedBuilder<T> builder(costMatrix, rcl);
+        std::vector<int> route, guide, relinked;
+
+        // Cada thread executa um bloco contíguo de iterações
+        int firstIteration = maxIterations * threadId / numThreads;
+        int lastIteration = maxIterations * (threadId + 1) / numThreads;
+
+        for (int iter = firstIteration; untilDeadline || iter < lastIteration; ++iter) {
+            if (iter > firstIteration && (expired(deadline) || globalBestCost.load() <= targetCost)) break;
+
+            // Construção aleatória-gulosa (reaproveita os buffers do construtor e a rota)
+            std::size_t alphaIndex = 0;
+            double iterationAlpha = alpha;
+            if (!reactiveByThread.empty()) {
+                alphaIndex = reactiveByThread[threadId].choose(generator);
+                iterationAlpha = reactiveByThread[threadId].alpha(alphaIndex);
+            }
+            builder.build(route, iterationAlpha, generator);
+
+            // Busca local
+            localSearch(route, costMatrix, method, neighbors, deadline);
+
+            // Avalia a solução; só guarda a rota se ela superar o melhor custo global
+            double cost = cycleCost(route, costMatrix);
+            if (!reactiveByThread.empty()) {
+                reactiveByThread[threadId].record(alphaIndex, cost);
+            }
+
+            // Religação de caminhos com a elite
+            if (relinking.mode != RelinkingMode::None && !expired(deadline)) {
+                double guideCost;
+                const double none = std::numeric_limits<double>::infinity();
+                if (elite.sample(generator, guide, guideCost) &&
+                    pathRelink(route, guide, costMatrix, relinking.mode, relinked) < none) {
+                    localSearch(relinked, costMatrix, method, neighbors, deadline);
+                    double relinkedCost = cycleCost(relinked, costMatrix);
+                    if (relinkedCost < cost) {
+                        route.swap(relinked);
+                        cost = relinkedCost;
+                    }
+                }
+                elite.tryAdd(route, cost);
+            }
+            if (publishBestCost(globalBestCost, cost)) {
+                bestCosts[threadId] = cost;
+                bestRoutes[threadId] = route;
+                if (trace != nullptr) trace->record(cost);
+            }
+        }
+    };
+
+    if (numThreads == 1) {
+        worker(0);
+    } else {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; ++t) {
+            threads.emplace_back(worker, t);
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+
+    if (!reactiveByThread.empty()) {
+        ReactiveAlpha total = *reactive;
+        for (const ReactiveAlpha& threadStats : reactiveByThread) {
+            total.merge(threadStats);
+        }
+        *reactive = total;
+    }
+
+    // Reduz para a melhor rota entre as threads
+    int bestThread = static_cast<int>(std::min_element(bestCosts.begin(), bestCosts.end()) - bestCosts.begin());
+    std::vector<int> bestRoute = bestRoutes[bestThread];
+
+    // Gira a rota para começar na cidade 0 (o Or-opt pode mover a cidade inicial)
+    std::rotate(bestRoute.begin(), std::find(bestRoute.begin(), bestRoute.end(), 0), bestRoute.end());
+
+    // Adiciona o retorno para a cidade inicial na melhor rota
+    double bestCost = cycleCost(bestRoute, costMatrix);
+    bestRoute.push_back(0);
+
+    return {bestRoute, bestCost};
+}
+
+// Converte o nome da busca local da linha de comando (2opt, 3opt, oropt ou lk)
+inline bool parseLocalSearchMethod(const std::string& name, LocalSearchMethod& method) {
+    if (name == "2opt") method = LocalSearchMethod::TwoOpt;
+    else if (name == "3opt") method = LocalSearchMethod::ThreeOpt;
+    else if (name == "oropt") method = LocalSearchMethod::OrOpt;
+    else if (name == "lk") method = LocalSearchMethod::LinKernighan;
+    else return false;
+    return true;
+}
+
+// Converte o sentido da religação de caminhos da linha de comando
+inline bool parseRelinkingMode(const std::string& name, RelinkingMode& mode) {
+    if (name == "pr-forward") mode = RelinkingMode::Forward;
+    else if (name == "pr-backward") mode = RelinkingMode::Backward;
+    else if (name == "pr-mixed") mode = RelinkingMode::Mixed;
+    else return false;
+    return true;
+}
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef COMMON_HELDKARP_HPP
+#define COMMON_HELDKARP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "CostMatrix.hpp"
+#include "Parallel.hpp"
+
+// Os subconjuntos das cidades 1..n-1 são máscaras de 32 bits
+constexpr std::size_t HELD_KARP_MAX_CITIES = 32;
+
+// Memória máxima padrão das tabelas (2 GiB, cerca de 24 cidades)
+constexpr std::size_t HELD_KARP_DEFAULT_MAX_BYTES = std::size_t(2) << 30;
+
+// Subconjuntos por tarefa do laço paralelo de uma camada
+constexpr std::size_t HELD_KARP_CHUNK = 4096;
+
+// Bytes das tabelas de custo e de predecessor para n cidades: 2^(n-1) subconjuntos x (n-1)
+// últimas cidades (máximo de size_t se n passar do limite das máscaras)
+inline std::size_t heldKarpMemoryBytes(std::size_t n) {
+    if (n < 2) return 0;
+    if (n > HELD_KARP_MAX_CITIES) return std::numeric_limits<std::size_t>::max();
+    std::size_t m = n - 1;
+    return (std::size_t(1) << m) * m * (sizeof(double) + sizeof(std::uint8_t));
+}
+
+// k-ésimo subconjunto (0-based, ordem colex, a mesma do maior inteiro seguinte com o mesmo
+// número de bits) de tamanho size entre m elementos; binomial[a][b] = C(a, b)
+inline std::uint32_t unrankSubset(std::uint64_t rank, std::size_t size, std::size_t m,
+                                  const std::vector<std::vector<std::uint64_t>>& binomial) {
+    std::uint32_t subset = 0;
+    std::size_t top = m;
+    for (std::size_t i = size; i > 0; --i) {
+        std::size_t c = top - 1;
+        while (binomial[c][i] > rank) --c;
+        subset |= std::uint32_t(1) << c;
+        rank -= binomial[c][i];
+        top = c;
+    }
+    return subset;
+}
+
+// Menor inteiro maior que subset com o mesmo número de bits (Gosper)
+inline std::uint32_t nextSubset(std::uint32_t subset) {
+    std::uint32_t lowest = subset & (~subset + 1);
+    std::uint32_t ripple = subset + lowest;
+    return (((ripple ^ subset) >> 2) / lowest) | ripple;
+}
+
+// Solução exata por programação dinâmica (Held–Karp), O(2^n n²) em tempo e O(2^n n) em
+// memória. A rota começa na cidade 0; custo(S, j) é o menor caminho que sai de 0, visita
+// exatamente as cidades de S e termina em j ∈ S. Os subconjuntos de uma camada (mesmo número
+// de cidades) só dependem da camada anterior e são divididos entre as threads; cada um grava
+// só a sua linha das tabelas. Vale para matrizes assimétricas. Devolve o caminho fechado e o
+// custo ótimo, ou um caminho vazio (custo infinito) se as tabelas passarem de maxBytes.
+template <typename T>
+std::pair<std::vector<int>, double> heldKarp(const CostMatrix<T>& costMatrix, int numThreads = 1,
+                                             std::size_t maxBytes = HELD_KARP_DEFAULT_MAX_BYTES) {
+    std::size_t n = costMatrix.size();
+    if (n == 0 || heldKarpMemoryBytes(n) > maxBytes) {
+        return {{}, std::numeric_limits<double>::infinity()};
+    }
+    if (n == 1) return {{0, 0}, 0.0};
+
+    // Cidade j + 1 é o bit j das máscaras
+    std::size_t m = n - 1;
+    std::size_t subsets = std::size_t(1) << m;
+    std::vector<double> cost(subsets * m, std::numeric_limits<double>::infinity());
+    std::vector<std::uint8_t> parent(subsets * m, 0);
+    for (std::size_t j = 0; j < m; ++j) {
+        cost[(std::size_t(1) << j) * m + j] = costMatrix(0, j + 1);
+    }
+
+    std::vector<std::vector<std::uint64_t>> binomial(m + 1, std::vector<std::uint64_t>(m + 1, 0));
+    for (std::size_t a = 0; a <= m; ++a) {
+        binomial[a][0] = 1;
+        for (std::size_t b = 1; b <= a; ++b) {
+            binomial[a][b] = binomial[a - 1][b - 1] + binomial[a - 1][b];
+        }
+    }
+
+    for (std::size_t size = 2; size <= m; ++size) {
+        std::uint64_t count = binomial[m][size];
+        std::size_t chunks = static_cast<std::size_t>((count + HELD_KARP_CHUNK - 1) / HELD_KARP_CHUNK);
+        parallelFor(chunks, numThreads, [&](std::size_t chunk, int) {
+            std::uint64_t first = static_cast<std::uint64_t>(chunk) * HELD_KARP_CHUNK;
+            std::uint64_t last = std::min<std::uint64_t>(count, first + HELD_KARP_CHUNK);
+            std::uint32_t subset = unrankSubset(first, size, m, binomial);
+            for (std::uint64_t rank = first; rank < last; ++rank, subset = nextSubset(subset)) {
+                for (std::uint32_t ends = subset; ends != 0; ends &= ends - 1) {
+                    int j = __builtin_ctz(ends);
+                    std::uint32_t previous = subset ^ (std::uint32_t(1) << j);
+                    const double* previousCost = cost.data() + previous * m;
+                    double best = std::numeric_limits<double>::infinity();
+                    int bestParent = 0;
+                    for (std::uint32_t rest = previous; rest != 0; rest &= rest - 1) {
+                        int i = __builtin_ctz(rest);
+                        double value = previousCost[i] + costMatrix(i + 1, j + 1);
+                        if (value < best) {
+                            best = value;
+                            bestParent = i;
+                        }
+                    }
+                    cost[subset * m + j] = best;
+                    parent[subset * m + j] = static_cast<std::uint8_t>(bestParent);
+                }
+            }
+        });
+    }
+
+    // Fecha o ciclo na cidade 0 e refaz o caminho pelos predecessores, do fim para o início
+    std::uint32_t full = static_cast<std::uint32_t>(subsets - 1);
+    double bestCost = std::numeric_limits<double>::infinity();
+    std::size_t last = 0;
+    for (std::size_t j = 0; j < m; ++j) {
+        double value = cost[full * m + j] + costMatrix(j + 1, 0);
+        if (value < bestCost) {
+            bestCost = value;
+            last = j;
+        }
+    }
+
+    std::vector<int> path(n + 1, 0);
+    std::uint32_t subset = full;
+    for (std::size_t p = n - 1; p > 0; --p) {
+        path[p] = static_cast<int>(last) + 1;
+        std::size_t previous = parent[subset * m + last];
+        subset ^= std::uint32_t(1) << last;
+        last = previous;
+    }
+    return {path, bestCost};
+}
+
+#endif
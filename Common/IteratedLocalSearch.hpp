@@ -0,0 +1,128 @@
+#ifndef COMMON_ITERATEDLOCALSEARCH_HPP
+#define COMMON_ITERATEDLOCALSEARCH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "CostMatrix.hpp"
+#include "Deadline.hpp"
+#include "Grasp.hpp"
+#include "LocalSearch.hpp"
+#include "NeighborLists.hpp"
+
+// Perturbação aplicada à solução corrente a cada iteração da ILS
+enum class Perturbation {
+    DoubleBridge,    // Troca de lugar dois trechos adjacentes curtos (A B C D -> A C B D)
+    SegmentReversal  // Recomeço aleatório de uma janela: algumas inversões sorteadas dentro dela
+};
+
+// Critério de aceitação da solução perturbada e reotimizada
+enum class Acceptance {
+    Better,    // Só se for melhor que a corrente
+    Threshold  // Se ficar a menos de threshold (fração) acima da melhor encontrada
+};
+
+struct IlsOptions {
+    int iterations = 1000;            // Iterações (<= 0 com prazo: até o prazo)
+    Perturbation perturbation = Perturbation::DoubleBridge;
+    std::size_t segmentLength = 50;   // Tamanho máximo dos trechos/janela da perturbação
+    Acceptance acceptance = Acceptance::Better;
+    double threshold = 0.01;
+};
+
+// Perturba a rota (ciclo) em volta de uma posição sorteada e devolve em touched as cidades das
+// pontas das arestas alteradas, de onde a busca local recomeça
+inline void perturb(std::vector<int>& route, const IlsOptions& options, std::mt19937& generator,
+                    std::vector<int>& touched) {
+    std::size_t n = route.size();
+    touched.clear();
+    std::size_t limit = std::max<std::size_t>(1, std::min(options.segmentLength, (n - 2) / 2));
+    std::uniform_int_distribution<std::size_t> positionDistribution(0, n - 1);
+    std::uniform_int_distribution<std::size_t> lengthDistribution(1, limit);
+    std::size_t start = positionDistribution(generator);
+    RouteState state(route);
+
+    if (options.perturbation == Perturbation::DoubleBridge) {
+        // Trechos B = [start+1, start+l1] e C = [start+l1+1, start+l1+l2]; o resto do ciclo é D A
+        std::size_t first = lengthDistribution(generator);
+        std::size_t second = lengthDistribution(generator);
+        for (std::size_t offset : {std::size_t(0), std::size_t(1), first, first + 1, first + second,
+                                   first + second + 1}) {
+            touched.push_back(state.at(start + offset));
+        }
+        state.swapAdjacentSegments((start + 1) % n, (start + first) % n, (start + first + second) % n);
+    } else {
+        // Janela [start, start+window-1]: todas as cidades dela e as duas vizinhas voltam à fila
+        std::size_t window = std::min(2 * limit, n - 1);
+        for (std::size_t offset = 0; offset <= window + 1; ++offset) {
+            touched.push_back(state.at(start + n - 1 + offset));
+        }
+        std::uniform_int_distribution<std::size_t> offsetDistribution(0, window - 1);
+        for (int k = 0; k < 3; ++k) {
+            std::size_t a = offsetDistribution(generator), b = offsetDistribution(generator);
+            if (a > b) std::swap(a, b);
+            state.reverse((start + a) % n, (start + b) % n);
+        }
+    }
+}
+
+// Busca local iterada sobre a rota (ciclo): a rota é otimizada uma vez por completo e, a cada
+// iteração, a corrente é perturbada e a busca local recomeça só das cidades em volta das arestas
+// alteradas. A rota termina com a melhor solução encontrada; devolve o seu custo.
+template <typename T>
+double iteratedLocalSearch(std::vector<int>& route, const CostMatrix<T>& costMatrix, LocalSearchMethod method,
+                           const IlsOptions& options, std::mt19937& generator,
+                           const NeighborLists* neighbors = nullptr, const Deadline* deadline = nullptr,
+                           ConvergenceTrace* trace = nullptr) {
+    localSearch(route, costMatrix, method, neighbors, deadline);
+    double bestCost = cycleCost(route, costMatrix);
+    if (trace) trace->record(bestCost);
+    if (route.size() < 8) return bestCost;
+
+    bool untilDeadline = options.iterations <= 0 && deadline != nullptr && deadline->limited();
+    std::vector<int> current(route), candidate;
+    double currentCost = bestCost;
+    std::vector<int> touched;
+    for (int iteration = 0; untilDeadline || iteration < options.iterations; ++iteration) {
+        if (expired(deadline)) break;
+
+        candidate = current;
+        perturb(candidate, options, generator, touched);
+        localSearch(candidate, costMatrix, method, neighbors, deadline, &touched);
+        double cost = cycleCost(candidate, costMatrix);
+
+        if (cost < bestCost - IMPROVEMENT_EPSILON) {
+            bestCost = cost;
+            route = candidate;
+            if (trace) trace->record(bestCost);
+        }
+        bool accept = options.acceptance == Acceptance::Better
+                          ? cost < currentCost - IMPROVEMENT_EPSILON
+                          : cost < bestCost * (1.0 + options.threshold);
+        if (accept) {
+            current.swap(candidate);
+            currentCost = cost;
+        }
+    }
+    return bestCost;
+}
+
+// Converte os nomes da linha de comando (double-bridge/segment-reversal e better/threshold)
+inline bool parsePerturbation(const std::string& name, Perturbation& perturbation) {
+    if (name == "double-bridge") perturbation = Perturbation::DoubleBridge;
+    else if (name == "segment-reversal") perturbation = Perturbation::SegmentReversal;
+    else return false;
+    return true;
+}
+
+inline bool parseAcceptance(const std::string& name, Acceptance& acceptance) {
+    if (name == "better") acceptance = Acceptance::Better;
+    else if (name == "threshold") acceptance = Acceptance::Threshold;
+    else return false;
+    return true;
+}
+
+#endif
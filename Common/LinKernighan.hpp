@@ -0,0 +1,157 @@
+#ifndef COMMON_LINKERNIGHAN_HPP
+#define COMMON_LINKERNIGHAN_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "CostMatrix.hpp"
+#include "LocalSearch.hpp"
+#include "NeighborLists.hpp"
+
+// Lin–Kernighan (profundidade variável) como vizinhança do driver de busca local.
+// A partir de t1 e da aresta (t1, t2) da rota, cada nível escolhe t3 entre as candidatas de t2
+// e t4 vizinho de t3, remove (t1, t2) e (t4, t3) e liga t2-t3 e t1-t4: é um 2-opt que inverte o
+// trecho t2..t4, e a nova aresta (t1, t4) passa a ser a aresta "aberta" do próximo nível. Os
+// níveis continuam enquanto o ganho parcial (sem fechar a rota) for positivo, até maxDepth;
+// no fim, a cadeia é desfeita até o nível de maior ganho real. No primeiro nível são tentadas
+// até breadth opções de t3 (em ordem de ganho); nos demais, só a melhor. Uma aresta ligada
+// pela cadeia não pode ser removida depois nela.
+template <typename T, typename Route = RouteState>
+class LinKernighanNeighborhood : public BasicNeighborhood<Route> {
+public:
+    LinKernighanNeighborhood(const CostMatrix<T>& costMatrix, const NeighborLists* neighbors = nullptr,
+                             int maxDepth = 50, int breadth = 5)
+        : cost_(costMatrix), neighbors_(neighbors), symmetric_(costMatrix.isSymmetric()), maxDepth_(maxDepth),
+          breadth_(breadth) {}
+
+    bool improveCity(int t1, Route& state, std::vector<int>& touched) override {
+        if (state.size() < 5) return false;
+        return improveFrom(t1, true, state, touched) || improveFrom(t1, false, state, touched);
+    }
+
+private:
+    // Nível aplicado: trecho invertido (posições) e as quatro cidades do movimento
+    struct Step {
+        std::size_t from, to;
+        int t2, t3, t4;
+    };
+
+    // Custo no sentido da rota: com forward = false a rota é percorrida ao contrário
+    double cost(int x, int y, bool forward) const { return forward ? cost_(x, y) : cost_(y, x); }
+    static int succ(const Route& state, int city, bool forward) { return forward ? state.next(city) : state.prev(city); }
+    static int pred(const Route& state, int city, bool forward) { return forward ? state.prev(city) : state.next(city); }
+
+    bool isAdded(int x, int y) const {
+        for (const auto& edge : added_) {
+            if ((edge.first == x && edge.second == y) || (edge.first == y && edge.second == x)) return true;
+        }
+        return false;
+    }
+
+    // Candidatas t3 de t2 que mantêm o ganho parcial positivo, com o ganho do nível
+    // (c(t4, t3) - c(t2, t3)) usado para ordená-las
+    void collectCandidates(int t1, int t2, bool forward, double openGain, const Route& state,
+                           std::vector<std::pair<double, int>>& candidates) const {
+        candidates.clear();
+        bool sorted = neighbors_ != nullptr && !neighbors_->empty() && symmetric_;
+        int t2Next = succ(state, t2, forward);
+        forEachCandidate(t2, state.size(), neighbors_, [&](int t3) {
+            double added = cost(t2, t3, forward);
+            // Lista ordenada: se esta aresta já zera o ganho, as próximas também zeram
+            if (openGain - added <= IMPROVEMENT_EPSILON) return !sorted;
+            if (t3 == t1 || t3 == t2Next) return true;
+            int t4 = pred(state, t3, forward);
+            if (isAdded(t4, t3)) return true;
+            candidates.emplace_back(cost(t4, t3, forward) - added, t3);
+            return true;
+        });
+    }
+
+    // Aplica o nível (t1, t2, t3) e devolve a variação do custo da rota
+    double applyStep(int t1, int t2, int t3, bool& forward, Route& state) {
+        std::size_t n = state.size();
+        int t4 = pred(state, t3, forward);
+        double delta = cost(t1, t4, forward) + cost(t2, t3, forward) - cost(t1, t2, forward) - cost(t4, t3, forward);
+
+        // Para frente: t1 t2 ... t4 t3 -> t1 t4 ... t2 t3; para trás, o mesmo lido ao contrário
+        std::size_t from = forward ? state.position(t2) : state.position(t4);
+        std::size_t to = forward ? state.position(t4) : state.position(t2);
+        if (!symmetric_) {
+            delta += reversalChange(state, cost_, from, to);
+        } else if (state.span(from, to) > n / 2) {
+            // Em matrizes simétricas inverter o complemento dá a mesma rota
+            std::size_t complementFrom = (to + 1) % n;
+            to = (from + n - 1) % n;
+            from = complementFrom;
+        }
+        state.reverse(from, to);
+        forward = state.next(t1) == t4;
+
+        steps_.push_back({from, to, t2, t3, t4});
+        added_.emplace_back(t2, t3);
+        return delta;
+    }
+
+    bool improveFrom(int t1, bool forward, Route& state, std::vector<int>& touched) {
+        int t2 = succ(state, t1, forward);
+        collectCandidates(t1, t2, forward, cost(t1, t2, forward), state, firstLevel_);
+        std::sort(firstLevel_.begin(), firstLevel_.end(),
+                  [](const auto& x, const auto& y) { return x.first > y.first; });
+        if (static_cast<int>(firstLevel_.size()) > breadth_) firstLevel_.resize(breadth_);
+
+        for (const auto& first : firstLevel_) {
+            steps_.clear();
+            added_.clear();
+            bool direction = forward;
+            double gain = -applyStep(t1, t2, first.second, direction, state);
+            double bestGain = IMPROVEMENT_EPSILON;
+            std::size_t bestSteps = 0;
+            if (gain > bestGain) {
+                bestGain = gain;
+                bestSteps = 1;
+            }
+
+            // Aprofunda a cadeia sempre pela melhor candidata
+            while (static_cast<int>(steps_.size()) < maxDepth_) {
+                int t2Next = succ(state, t1, direction);
+                collectCandidates(t1, t2Next, direction, gain + cost(t1, t2Next, direction), state, candidates_);
+                if (candidates_.empty()) break;
+                int t3 = std::max_element(candidates_.begin(), candidates_.end())->second;
+                gain -= applyStep(t1, t2Next, t3, direction, state);
+                if (gain > bestGain) {
+                    bestGain = gain;
+                    bestSteps = steps_.size();
+                }
+            }
+
+            // Desfaz os níveis depois do melhor (cada inversão desfaz a si mesma)
+            while (steps_.size() > bestSteps) {
+                state.reverse(steps_.back().from, steps_.back().to);
+                steps_.pop_back();
+            }
+            if (bestSteps > 0) {
+                touched.push_back(t1);
+                for (const Step& step : steps_) {
+                    touched.insert(touched.end(), {step.t2, step.t3, step.t4});
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const CostMatrix<T>& cost_;
+    const NeighborLists* neighbors_;
+    bool symmetric_;
+    int maxDepth_;
+    int breadth_;
+
+    std::vector<Step> steps_;
+    std::vector<std::pair<int, int>> added_;
+    std::vector<std::pair<double, int>> firstLevel_;
+    std::vector<std::pair<double, int>> candidates_;
+};
+
+#endif
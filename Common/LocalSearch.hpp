@@ -0,0 +1,672 @@
+#ifndef COMMON_LOCALSEARCH_HPP
+#define COMMON_LOCALSEARCH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "CostMatrix.hpp"
+#include "Deadline.hpp"
+#include "NeighborLists.hpp"
+
+// Melhora mínima para um movimento ser aceito (evita ciclos por erro de arredondamento)
+constexpr double IMPROVEMENT_EPSILON = 1e-9;
+
+// Custo da rota cíclica (sem repetir a cidade inicial no fim), incluindo a volta ao início
+template <typename T>
+double cycleCost(const std::vector<int>& route, const CostMatrix<T>& cost) {
+    double total = 0.0;
+    for (std::size_t p = 0; p + 1 < route.size(); ++p) total += cost(route[p], route[p + 1]);
+    if (!route.empty()) total += cost(route.back(), route.front());
+    return total;
+}
+
+// Rota cíclica (sem repetir a cidade inicial no fim) e a posição de cada cidade nela.
+// Todas as operações mantêm as posições atualizadas. Inverter um trecho custa O(tamanho do
+// trecho); para instâncias grandes há TwoLevelRoute, com a mesma interface.
+class RouteState {
+public:
+    explicit RouteState(std::vector<int>& route) : route_(route), position_(route.size()) {
+        for (std::size_t p = 0; p < route_.size(); ++p) {
+            position_[route_[p]] = p;
+        }
+    }
+
+    std::size_t size() const { return route_.size(); }
+
+    // Contador de alterações da rota (muda a cada inversão ou troca)
+    std::size_t version() const { return version_; }
+
+    // A rota já é alterada no próprio vetor; só copia se for outro vetor
+    void store(std::vector<int>& route) const {
+        if (&route != &route_) route = route_;
+    }
+
+    // Cidade na posição p (com p tomado de forma cíclica)
+    int at(std::size_t p) const { return route_[p % route_.size()]; }
+    std::size_t position(int city) const { return position_[city]; }
+    int next(int city) const { return route_[(position_[city] + 1) % route_.size()]; }
+    int prev(int city) const { return route_[(position_[city] + route_.size() - 1) % route_.size()]; }
+
+    // Número de posições de from até to, andando para frente (inclusive)
+    std::size_t span(std::size_t from, std::size_t to) const { return (to + route_.size() - from) % route_.size() + 1; }
+
+    // Verifica se b está no caminho que vai de a até c andando para frente
+    bool between(int a, int b, int c) const {
+        std::size_t pa = position_[a];
+        return span(pa, position_[b]) <= span(pa, position_[c]);
+    }
+
+    // Inverte o trecho cíclico que vai da posição from até a posição to (inclusive)
+    void reverse(std::size_t from, std::size_t to) {
+        std::size_t n = route_.size();
+        std::size_t length = span(from, to);
+        ++version_;
+        for (std::size_t k = 0; k < length / 2; ++k) {
+            std::size_t left = (from + k) % n;
+            std::size_t right = (to + n - k) % n;
+            std::swap(route_[left], route_[right]);
+            position_[route_[left]] = left;
+            position_[route_[right]] = right;
+        }
+    }
+
+    // Troca de lugar os trechos adjacentes [from, middle] e [middle+1, to] (três inversões)
+    void swapAdjacentSegments(std::size_t from, std::size_t middle, std::size_t to) {
+        std::size_t n = route_.size();
+        reverse(from, middle);
+        reverse((middle + 1) % n, to);
+        reverse(from, to);
+    }
+
+    // Troca duas cidades de posição
+    void swapCities(int a, int b) {
+        ++version_;
+        std::size_t pa = position_[a];
+        std::size_t pb = position_[b];
+        std::swap(route_[pa], route_[pb]);
+        position_[a] = pb;
+        position_[b] = pa;
+    }
+
+private:
+    std::vector<int>& route_;
+    std::vector<std::size_t> position_;
+    std::size_t version_ = 0;
+};
+
+// Vizinhança que pode ser usada pelo driver de busca local, para uma representação de rota
+// (RouteState ou TwoLevelRoute)
+template <typename Route>
+class BasicNeighborhood {
+public:
+    virtual ~BasicNeighborhood() = default;
+
+    // Procura um movimento de melhora que tenha city como extremidade. Se encontrar, aplica o
+    // movimento na rota e coloca em touched as cidades das arestas alteradas.
+    virtual bool improveCity(int city, Route& state, std::vector<int>& touched) = 0;
+};
+
+using Neighborhood = BasicNeighborhood<RouteState>;
+
+// Chama visit(c) para cada candidata c da cidade: os vizinhos da lista, em ordem crescente de
+// custo, ou todas as outras cidades quando não há listas. visit devolve false para parar.
+template <typename Visit>
+void forEachCandidate(int city, std::size_t n, const NeighborLists* neighbors, Visit visit) {
+    if (neighbors != nullptr && !neighbors->empty()) {
+        for (const int* c = neighbors->begin(city); c != neighbors->end(city); ++c) {
+            if (!visit(*c)) return;
+        }
+    } else {
+        for (std::size_t c = 0; c < n; ++c) {
+            if (static_cast<int>(c) != city && !visit(static_cast<int>(c))) return;
+        }
+    }
+}
+
+// Driver de busca local com bits "não olhe" (don't-look bits).
+// Todas as cidades começam ativas em uma fila FIFO. Cada cidade retirada da fila é examinada
+// pelas vizinhanças, na ordem dada; quando uma delas aplica um movimento, as extremidades das
+// arestas alteradas (e a própria cidade) voltam para a fila. Uma cidade sem melhora fica com o
+// bit "não olhe" ligado até que um movimento toque uma aresta sua. A busca termina quando a
+// fila esvazia, sem recomeçar a varredura do início a cada melhora, ou quando o prazo expira
+// (a rota fica com os movimentos aplicados até ali). Com startCities, só essas cidades começam
+// ativas: depois de uma perturbação local basta reparar a rota em volta das arestas alteradas.
+template <typename Route = RouteState>
+void runLocalSearch(std::vector<int>& route, const std::vector<BasicNeighborhood<Route>*>& neighborhoods,
+                    const Deadline* deadline = nullptr, const std::vector<int>* startCities = nullptr) {
+    std::size_t n = route.size();
+    if (n < 5) return;
+
+    Route state(route);
+    std::deque<int> queue;
+    std::vector<char> active(n, startCities == nullptr);
+    if (startCities == nullptr) {
+        queue.assign(route.begin(), route.end());
+    } else {
+        for (int city : *startCities) {
+            if (!active[city]) {
+                active[city] = 1;
+                queue.push_back(city);
+            }
+        }
+    }
+    std::vector<int> touched;
+
+    while (!queue.empty() && !expired(deadline)) {
+        int city = queue.front();
+        queue.pop_front();
+        active[city] = 0;
+
+        for (BasicNeighborhood<Route>* neighborhood : neighborhoods) {
+            touched.clear();
+            if (neighborhood->improveCity(city, state, touched)) {
+                touched.push_back(city);
+                for (int t : touched) {
+                    if (!active[t]) {
+                        active[t] = 1;
+                        queue.push_back(t);
+                    }
+                }
+                break;
+            }
+        }
+    }
+    state.store(route);
+}
+
+// Variação de custo das arestas internas do trecho [from, to] ao inverter seu sentido (zero
+// em matrizes simétricas; O(tamanho do trecho))
+template <typename Route, typename T>
+double reversalChange(const Route& state, const CostMatrix<T>& cost, std::size_t from, std::size_t to) {
+    double change = 0;
+    int x = state.at(from);
+    for (std::size_t k = 1; k < state.span(from, to); ++k) {
+        int y = state.next(x);
+        change += cost(y, x) - cost(x, y);
+        x = y;
+    }
+    return change;
+}
+
+// Somas acumuladas dos custos das arestas da rota nos dois sentidos: a variação ao inverter um
+// trecho em uma matriz assimétrica sai em O(1), em vez de O(tamanho do trecho) como em
+// reversalChange. As somas são refeitas (O(n)) só quando a rota mudou desde a última consulta,
+// ou seja, uma vez por movimento aplicado, que já custa O(n) no pior caso.
+template <typename T>
+class ReversalCost {
+public:
+    explicit ReversalCost(const CostMatrix<T>& costMatrix) : cost_(costMatrix) {}
+
+    // Atualiza as somas se a rota mudou (ou se é outra rota)
+    template <typename Route>
+    void sync(const Route& state) {
+        if (state_ == &state && version_ == state.version()) return;
+        state_ = &state;
+        version_ = state.version();
+
+        // forward_[p]: custo das arestas at(k) -> at(k+1), k < p (a última fecha o ciclo)
+        std::size_t n = state.size();
+        forward_.assign(n + 1, 0.0);
+        backward_.assign(n + 1, 0.0);
+        int x = state.at(0);
+        for (std::size_t p = 0; p < n; ++p) {
+            int y = state.next(x);
+            forward_[p + 1] = forward_[p] + cost_(x, y);
+            backward_[p + 1] = backward_[p] + cost_(y, x);
+            x = y;
+        }
+    }
+
+    // Variação de custo das arestas internas do trecho cíclico [from, to] ao inverter seu sentido
+    double change(std::size_t from, std::size_t to) const {
+        if (from <= to) {
+            return (backward_[to] - backward_[from]) - (forward_[to] - forward_[from]);
+        }
+        std::size_t n = forward_.size() - 1;
+        return (backward_[n] - backward_[from] + backward_[to]) - (forward_[n] - forward_[from] + forward_[to]);
+    }
+
+private:
+    const CostMatrix<T>& cost_;
+    const void* state_ = nullptr;
+    std::size_t version_ = 0;
+    std::vector<double> forward_;
+    std::vector<double> backward_;
+};
+
+// 2-opt: remove as arestas (a, succ(a)) e (c, succ(c)) e religa invertendo o trecho entre elas
+// (e o caso simétrico com os predecessores). A variação das arestas externas é O(1); em
+// matrizes assimétricas soma-se também a mudança de sentido das arestas internas do trecho,
+// também O(1) pelas somas acumuladas de ReversalCost.
+template <typename T, typename Route = RouteState>
+class TwoOptNeighborhood : public BasicNeighborhood<Route> {
+public:
+    TwoOptNeighborhood(const CostMatrix<T>& costMatrix, const NeighborLists* neighbors = nullptr)
+        : cost_(costMatrix), neighbors_(neighbors), symmetric_(costMatrix.isSymmetric()), reversal_(costMatrix) {}
+
+    bool improveCity(int a, Route& state, std::vector<int>& touched) override {
+        std::size_t n = state.size();
+        if (!symmetric_) reversal_.sync(state);
+        double bestDelta = -IMPROVEMENT_EPSILON;
+        std::size_t bestFrom = 0, bestTo = 0;
+        int bestC = -1, bestD = -1, bestB = -1;
+        // Sem listas (k = 0) a varredura é pela ordem dos índices e não pode parar antes
+        bool sorted = neighbors_ != nullptr && !neighbors_->empty() && symmetric_;
+
+        for (int direction = 0; direction < 2; ++direction) {
+            bool forward = direction == 0;
+            int b = forward ? state.next(a) : state.prev(a);
+            double removedAB = forward ? cost_(a, b) : cost_(b, a);
+
+            forEachCandidate(a, n, neighbors_, [&](int c) {
+                // Lista ordenada: sem ganho na primeira aresta nova, os próximos também não têm
+                if (sorted && cost_(a, c) >= removedAB) return false;
+                if (c == b) return true;
+                int d = forward ? state.next(c) : state.prev(c);
+                if (d == a) return true;
+
+                // Para frente: a b ... c d  ->  a c ... b d   (inverte de b até c)
+                // Para trás:   d c ... b a  ->  d b ... c a   (inverte de c até b)
+                std::size_t from = forward ? state.position(b) : state.position(c);
+                std::size_t to = forward ? state.position(c) : state.position(b);
+                double delta = forward ? cost_(a, c) + cost_(b, d) - removedAB - cost_(c, d)
+                                       : cost_(c, a) + cost_(d, b) - removedAB - cost_(d, c);
+                if (!symmetric_) delta += reversal_.change(from, to);
+
+                if (delta < bestDelta) {
+                    bestDelta = delta;
+                    bestFrom = from;
+                    bestTo = to;
+                    bestB = b;
+                    bestC = c;
+                    bestD = d;
+                }
+                return true;
+            });
+        }
+
+        if (bestC < 0) return false;
+        // Em matrizes simétricas inverter o complemento dá a mesma rota; inverte o menor trecho
+        if (symmetric_ && state.span(bestFrom, bestTo) > n / 2) {
+            state.reverse((bestTo + 1) % n, (bestFrom + n - 1) % n);
+        } else {
+            state.reverse(bestFrom, bestTo);
+        }
+        touched.insert(touched.end(), {bestB, bestC, bestD});
+        return true;
+    }
+
+private:
+    const CostMatrix<T>& cost_;
+    const NeighborLists* neighbors_;
+    bool symmetric_;
+    ReversalCost<T> reversal_;
+};
+
+// Or-opt: move um segmento de 1 a 3 cidades que começa ou termina na cidade para outra aresta
+// da rota, no sentido original ou invertido. A variação é calculada em O(1) pelas arestas
+// removidas e inseridas (e pelas arestas internas do segmento quando ele é invertido).
+template <typename T, typename Route = RouteState>
+class OrOptNeighborhood : public BasicNeighborhood<Route> {
+public:
+    OrOptNeighborhood(const CostMatrix<T>& costMatrix, const NeighborLists* neighbors = nullptr, int maxLength = 3)
+        : cost_(costMatrix), neighbors_(neighbors), maxLength_(maxLength) {}
+
+    bool improveCity(int city, Route& state, std::vector<int>& touched) override {
+        std::size_t n = state.size();
+        bool useNeighbors = neighbors_ != nullptr && !neighbors_->empty();
+
+        double bestDelta = -IMPROVEMENT_EPSILON;
+        int bestFirst = -1, bestLast = -1, bestP = -1;
+        bool bestReversed = false;
+
+        for (int length = 1; length <= maxLength_ && static_cast<std::size_t>(length) + 2 < n; ++length) {
+            // Segmentos que começam na cidade e (para length > 1) que terminam nela
+            for (int side = 0; side < (length > 1 ? 2 : 1); ++side) {
+                int first = city, last = city;
+                for (int k = 1; k < length; ++k) {
+                    if (side == 0) last = state.next(last);
+                    else first = state.prev(first);
+                }
+                int prev = state.prev(first);
+                int next = state.next(last);
+                std::size_t start = state.position(first);
+
+                double removeGain = cost_(prev, first) + cost_(last, next) - cost_(prev, next);
+                double internalForward = 0, internalBackward = 0;
+                for (int x = first; x != last; x = state.next(x)) {
+                    int y = state.next(x);
+                    internalForward += cost_(x, y);
+                    internalBackward += cost_(y, x);
+                }
+
+                // Reinsere entre p e q = succ(p), se a aresta estiver fora do segmento
+                auto evaluate = [&](int p) {
+                    std::size_t offset = (state.position(p) + n - start) % n;
+                    if (offset < static_cast<std::size_t>(length) || offset == n - 1) return;
+                    int q = state.next(p);
+
+                    double base = -removeGain - cost_(p, q);
+                    double forwardDelta = base + cost_(p, first) + cost_(last, q);
+                    double reversedDelta = base + cost_(p, last) + cost_(first, q) + internalBackward - internalForward;
+
+                    if (forwardDelta < bestDelta) {
+                        bestDelta = forwardDelta;
+                        bestReversed = false;
+                        bestFirst = first, bestLast = last, bestP = p;
+                    }
+                    if (length > 1 && reversedDelta < bestDelta) {
+                        bestDelta = reversedDelta;
+                        bestReversed = true;
+                        bestFirst = first, bestLast = last, bestP = p;
+                    }
+                };
+
+                if (useNeighbors) {
+                    // Vizinho c de uma ponta: inserir logo depois de c ou logo antes de c
+                    for (int endpoint : {first, last}) {
+                        for (const int* c = neighbors_->begin(endpoint); c != neighbors_->end(endpoint); ++c) {
+                            evaluate(*c);
+                            evaluate(state.prev(*c));
+                        }
+                    }
+                } else {
+                    int p = state.at(0);
+                    for (std::size_t j = 0; j < n; ++j, p = state.next(p)) {
+                        evaluate(p);
+                    }
+                }
+            }
+        }
+
+        if (bestP < 0) return false;
+
+        int q = state.next(bestP);
+        touched.insert(touched.end(), {state.prev(bestFirst), state.next(bestLast), bestFirst, bestLast, bestP, q});
+
+        // Troca o segmento com o trecho que o separa de p (ou de q), o que for menor
+        std::size_t bestStart = state.position(bestFirst);
+        std::size_t bestEnd = state.position(bestLast);
+        std::size_t pPosition = state.position(bestP);
+        std::size_t forwardSpan = state.span((bestEnd + 1) % n, pPosition);
+        std::size_t backwardSpan = state.span((pPosition + 1) % n, (bestStart + n - 1) % n);
+        if (forwardSpan <= backwardSpan) {
+            state.swapAdjacentSegments(bestStart, bestEnd, pPosition);
+        } else {
+            state.swapAdjacentSegments((pPosition + 1) % n, (bestStart + n - 1) % n, bestEnd);
+        }
+        if (bestReversed) {
+            state.reverse(state.position(bestFirst), state.position(bestLast));
+        }
+        return true;
+    }
+
+private:
+    const CostMatrix<T>& cost_;
+    const NeighborLists* neighbors_;
+    int maxLength_;
+};
+
+// Calcula, apenas pelas arestas alteradas, a melhor reconexão 3-opt para as arestas
+// removidas (a,b), (c,d) e (e,f), onde S1 = b..c e S2 = d..e são os segmentos entre elas.
+// Retorna o número da reconexão (1 a 7, ou 0 se nenhuma) e grava sua variação em delta.
+// Em matrizes assimétricas as reconexões que invertem segmentos somam a variação das arestas
+// internas invertidas (reverseS1, reverseS2 e reverseBoth, de S1, S2 e S1+S2); sem elas
+// (reversal = nullptr) só a reconexão 6, sem inversão, tem variação exata.
+template <typename T>
+int bestThreeOptCase(int a, int b, int c, int d, int e, int f, const CostMatrix<T>& costMatrix, bool symmetric,
+                     double& delta, const double* reversal = nullptr) {
+    double removed = costMatrix(a, b) + costMatrix(c, d) + costMatrix(e, f);
+
+    double candidates[8];
+    candidates[0] = 0;
+    // 1. Inverte S1:              a-c, b-d
+    candidates[1] = costMatrix(a, c) + costMatrix(b, d) - costMatrix(a, b) - costMatrix(c, d);
+    // 2. Inverte S2:              c-e, d-f
+    candidates[2] = costMatrix(c, e) + costMatrix(d, f) - costMatrix(c, d) - costMatrix(e, f);
+    // 3. Inverte S1+S2:           a-e, b-f
+    candidates[3] = costMatrix(a, e) + costMatrix(b, f) - costMatrix(a, b) - costMatrix(e, f);
+    // 4. Inverte S1 e S2:         a-c, b-e, d-f
+    candidates[4] = costMatrix(a, c) + costMatrix(b, e) + costMatrix(d, f) - removed;
+    // 5. S2 invertido, depois S1: a-e, d-b, c-f
+    candidates[5] = costMatrix(a, e) + costMatrix(d, b) + costMatrix(c, f) - removed;
+    // 6. Troca S1 e S2:           a-d, e-b, c-f
+    candidates[6] = costMatrix(a, d) + costMatrix(e, b) + costMatrix(c, f) - removed;
+    // 7. S2, depois S1 invertido: a-d, e-c, b-f
+    candidates[7] = costMatrix(a, d) + costMatrix(e, c) + costMatrix(b, f) - removed;
+
+    if (!symmetric) {
+        if (reversal == nullptr) {
+            delta = candidates[6];
+            return 6;
+        }
+        candidates[1] += reversal[0];
+        candidates[2] += reversal[1];
+        candidates[3] += reversal[2];
+        candidates[4] += reversal[0] + reversal[1];
+        candidates[5] += reversal[1];
+        candidates[7] += reversal[0];
+    }
+
+    int bestCase = 0;
+    for (int moveCase = 1; moveCase < 8; ++moveCase) {
+        if (candidates[moveCase] < candidates[bestCase]) {
+            bestCase = moveCase;
+        }
+    }
+    delta = candidates[bestCase];
+    return bestCase;
+}
+
+// 3-opt: remove as arestas que saem de a = route[i], route[i+j] e route[i+k] (0 < j < k < n,
+// posições relativas a i) e testa as 7 reconexões em O(1). Sem listas de candidatas, todos os
+// pares (j, k) são avaliados; com listas, a primeira aresta nova (a, X) precisa ligar a a um
+// vizinho mais próximo que a sua sucessora, e X fixa j ou k.
+template <typename T, typename Route = RouteState>
+class ThreeOptNeighborhood : public BasicNeighborhood<Route> {
+public:
+    ThreeOptNeighborhood(const CostMatrix<T>& costMatrix, const NeighborLists* neighbors = nullptr)
+        : cost_(costMatrix), neighbors_(neighbors), symmetric_(costMatrix.isSymmetric()), reversal_(costMatrix) {}
+
+    bool improveCity(int a, Route& state, std::vector<int>& touched) override {
+        if (state.size() < 6) return false;
+        if (!symmetric_) reversal_.sync(state);
+        int b = state.next(a);
+        int last = state.prev(a);
+
+        // As cidades são percorridas com next a partir de a, sem consultar posições
+        if (neighbors_ == nullptr || neighbors_->empty()) {
+            for (int c = b; c != last; c = state.next(c)) {
+                for (int e = c; e != last;) {
+                    e = state.next(e);
+                    if (tryMove(state, a, c, e, touched)) return true;
+                }
+            }
+            return false;
+        }
+
+        double removedCost = cost_(a, b);
+        for (const int* x = neighbors_->begin(a); x != neighbors_->end(a); ++x) {
+            if (cost_(a, *x) >= removedCost) break;
+            if (*x == b) continue;
+
+            // X como fim de S1 (c)
+            for (int e = *x; e != last;) {
+                e = state.next(e);
+                if (tryMove(state, a, *x, e, touched)) return true;
+            }
+            // X como início de S2 (d)
+            int c = state.prev(*x);
+            for (int e = *x;; e = state.next(e)) {
+                if (tryMove(state, a, c, e, touched)) return true;
+                if (e == last) break;
+            }
+            // X como fim de S2 (e)
+            for (int c = b; c != *x; c = state.next(c)) {
+                if (tryMove(state, a, c, *x, touched)) return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    // Avalia as arestas que saem de a, c e e (nessa ordem na rota) e aplica a melhor
+    // reconexão se ela melhorar a rota
+    bool tryMove(Route& state, int a, int c, int e, std::vector<int>& touched) {
+        int b = state.next(a);
+        int d = state.next(c);
+        int f = state.next(e);
+
+        double delta;
+        int moveCase;
+        if (symmetric_) {
+            moveCase = bestThreeOptCase(a, b, c, d, e, f, cost_, true, delta);
+        } else {
+            std::size_t pb = state.position(b), pc = state.position(c);
+            std::size_t pd = state.position(d), pe = state.position(e);
+            double reversal[3] = {reversal_.change(pb, pc), reversal_.change(pd, pe), reversal_.change(pb, pe)};
+            moveCase = bestThreeOptCase(a, b, c, d, e, f, cost_, false, delta, reversal);
+        }
+        if (delta >= -IMPROVEMENT_EPSILON) return false;
+
+        std::size_t s1From = state.position(b), s1To = state.position(c);
+        std::size_t s2From = state.position(d), s2To = state.position(e);
+
+        switch (moveCase) {
+            case 1: state.reverse(s1From, s1To); break;
+            case 2: state.reverse(s2From, s2To); break;
+            case 3: state.reverse(s1From, s2To); break;
+            case 4: state.reverse(s1From, s1To); state.reverse(s2From, s2To); break;
+            case 5: state.reverse(s1From, s1To); state.reverse(s1From, s2To); break;
+            case 6: state.swapAdjacentSegments(s1From, s1To, s2To); break;
+            case 7: state.reverse(s2From, s2To); state.reverse(s1From, s2To); break;
+            default: return false;
+        }
+        touched.insert(touched.end(), {a, b, c, d, e, f});
+        return true;
+    }
+
+    const CostMatrix<T>& cost_;
+    const NeighborLists* neighbors_;
+    bool symmetric_;
+    ReversalCost<T> reversal_;
+};
+
+// Variação de custo ao trocar de posição as cidades a e x na rota (O(1)), tratando o caso em
+// que as duas são vizinhas na rota
+template <typename Route, typename T>
+double swapDelta(const Route& state, const CostMatrix<T>& cost, int a, int x) {
+    if (state.next(x) == a) std::swap(a, x);
+    int pa = state.prev(a), nx = state.next(x);
+    if (state.next(a) == x) {
+        // ... pa a x nx ...  ->  ... pa x a nx ...
+        return cost(pa, x) + cost(x, a) + cost(a, nx) - cost(pa, a) - cost(a, x) - cost(x, nx);
+    }
+    int na = state.next(a), px = state.prev(x);
+    return cost(pa, x) + cost(x, na) + cost(px, a) + cost(a, nx) - cost(pa, a) - cost(a, na) - cost(px, x) -
+           cost(x, nx);
+}
+
+// Troca de vizinhos (swap): troca a cidade de posição com outra. Com listas de candidatas,
+// só testa as trocas que colocam a cidade ao lado de um dos seus vizinhos mais próximos.
+template <typename T, typename Route = RouteState>
+class SwapNeighborhood : public BasicNeighborhood<Route> {
+public:
+    SwapNeighborhood(const CostMatrix<T>& costMatrix, const NeighborLists* neighbors = nullptr)
+        : cost_(costMatrix), neighbors_(neighbors) {}
+
+    bool improveCity(int a, Route& state, std::vector<int>& touched) override {
+        std::size_t n = state.size();
+        bool useNeighbors = neighbors_ != nullptr && !neighbors_->empty();
+        double bestDelta = -IMPROVEMENT_EPSILON;
+        int bestX = -1;
+
+        auto evaluate = [&](int x) {
+            if (x == a) return;
+            double delta = swapDelta(state, cost_, a, x);
+            if (delta < bestDelta) {
+                bestDelta = delta;
+                bestX = x;
+            }
+        };
+
+        forEachCandidate(a, n, neighbors_, [&](int c) {
+            if (useNeighbors) {
+                evaluate(state.next(c));
+                evaluate(state.prev(c));
+            } else {
+                evaluate(c);
+            }
+            return true;
+        });
+
+        if (bestX < 0) return false;
+        touched.insert(touched.end(), {state.prev(a), state.next(a), bestX, state.prev(bestX), state.next(bestX)});
+        state.swapCities(a, bestX);
+        return true;
+    }
+
+private:
+    const CostMatrix<T>& cost_;
+    const NeighborLists* neighbors_;
+};
+
+// Política de aceitação das buscas por varredura
+enum class ImprovementPolicy {
+    FirstImprovement, // Aplica cada movimento de melhora assim que o encontra e segue a varredura
+    BestImprovement   // Varre todos os movimentos e aplica só o melhor
+};
+
+// Troca de vizinhos (swap) em um caminho fechado (path[0] == path.back() fica fixa), alterando
+// o caminho no lugar. Cada troca é avaliada em O(1) por swapDelta, e o custo é mantido somando
+// as variações, então uma varredura completa custa O(n^2). As varreduras se repetem até não
+// haver troca de melhora ou até o prazo expirar. Devolve o custo final do caminho.
+template <typename T>
+double swapLocalSearch(std::vector<int>& path, const CostMatrix<T>& cost, double pathCost,
+                       ImprovementPolicy policy = ImprovementPolicy::FirstImprovement,
+                       const Deadline* deadline = nullptr) {
+    if (path.size() < 4) return pathCost;
+    std::vector<int> cycle(path.begin(), path.end() - 1);
+    std::size_t n = cycle.size();
+    RouteState state(cycle);
+
+    bool improved = true;
+    while (improved && !expired(deadline)) {
+        improved = false;
+        double bestDelta = -IMPROVEMENT_EPSILON;
+        int bestA = -1, bestX = -1;
+
+        for (std::size_t i = 1; i + 1 < n && !expired(deadline); ++i) {
+            for (std::size_t j = i + 1; j < n; ++j) {
+                int a = state.at(i);
+                int x = state.at(j);
+                double delta = swapDelta(state, cost, a, x);
+                if (delta >= bestDelta) continue;
+
+                if (policy == ImprovementPolicy::FirstImprovement) {
+                    state.swapCities(a, x);
+                    pathCost += delta;
+                    improved = true;
+                } else {
+                    bestDelta = delta;
+                    bestA = a;
+                    bestX = x;
+                }
+            }
+        }
+
+        if (bestA >= 0) {
+            state.swapCities(bestA, bestX);
+            pathCost += bestDelta;
+            improved = true;
+        }
+    }
+
+    std::copy(cycle.begin(), cycle.end(), path.begin());
+    return pathCost;
+}
+
+#endif
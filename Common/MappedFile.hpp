@@ -0,0 +1,132 @@
+#ifndef COMMON_MAPPEDFILE_HPP
+#define COMMON_MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Arquivo mapeado em memória somente para leitura.
+// O conteúdo fica acessível por data()/size() sem cópia enquanto o objeto existir.
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& filePath) { open(filePath); }
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept { moveFrom(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    // Mapeia o arquivo; retorna false se ele não puder ser aberto
+    bool open(const std::string& filePath) {
+        close();
+#ifdef _WIN32
+        file_ = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file_, &fileSize)) {
+            close();
+            return false;
+        }
+        size_ = static_cast<std::size_t>(fileSize.QuadPart);
+        opened_ = true;
+        if (size_ == 0) return true;
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_ == nullptr) {
+            close();
+            return false;
+        }
+        data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        if (data_ == nullptr) {
+            close();
+            return false;
+        }
+#else
+        int descriptor = ::open(filePath.c_str(), O_RDONLY);
+        if (descriptor < 0) return false;
+        struct stat info;
+        if (fstat(descriptor, &info) != 0) {
+            ::close(descriptor);
+            return false;
+        }
+        size_ = static_cast<std::size_t>(info.st_size);
+        opened_ = true;
+        if (size_ > 0) {
+            void* address = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (address == MAP_FAILED) {
+                ::close(descriptor);
+                size_ = 0;
+                opened_ = false;
+                return false;
+            }
+            madvise(address, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(address);
+        }
+        // O mapeamento continua válido depois de fechar o descritor
+        ::close(descriptor);
+#endif
+        return true;
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (data_ != nullptr) UnmapViewOfFile(data_);
+        if (mapping_ != nullptr) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+        mapping_ = nullptr;
+        file_ = INVALID_HANDLE_VALUE;
+#else
+        if (data_ != nullptr) munmap(const_cast<char*>(data_), size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        opened_ = false;
+    }
+
+    bool isOpen() const { return opened_; }
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    void moveFrom(MappedFile& other) {
+        data_ = other.data_;
+        size_ = other.size_;
+        opened_ = other.opened_;
+#ifdef _WIN32
+        file_ = other.file_;
+        mapping_ = other.mapping_;
+        other.file_ = INVALID_HANDLE_VALUE;
+        other.mapping_ = nullptr;
+#endif
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.opened_ = false;
+    }
+
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool opened_ = false;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+};
+
+#endif
@@ -0,0 +1,207 @@
+#ifndef COMMON_NEARESTNEIGHBOR_HPP
+#define COMMON_NEARESTNEIGHBOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "CostMatrix.hpp"
+#include "NeighborLists.hpp"
+
+// Índice do bit menos significativo ligado (word != 0)
+inline int lowestBit(std::uint64_t word) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int bit = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+// Conjunto de cidades visitadas, um bit por cidade (64 por palavra)
+class VisitedSet {
+public:
+    void reset(std::size_t n) {
+        n_ = n;
+        words_.assign((n + 63) / 64, 0);
+    }
+    bool test(int city) const { return (words_[city >> 6] >> (city & 63)) & 1; }
+    void set(int city) { words_[city >> 6] |= std::uint64_t(1) << (city & 63); }
+
+    // Chama visit(c) para cada cidade não visitada, em ordem crescente, pulando de 64 em 64
+    // as cidades já visitadas
+    template <typename Visit>
+    void forEachUnvisited(Visit visit) const {
+        for (std::size_t k = 0; k < words_.size(); ++k) {
+            std::uint64_t free = ~words_[k];
+            if (k + 1 == words_.size() && n_ % 64 != 0) free &= (std::uint64_t(1) << (n_ % 64)) - 1;
+            while (free != 0) {
+                visit(static_cast<int>(k * 64 + lowestBit(free)));
+                free &= free - 1;
+            }
+        }
+    }
+
+private:
+    std::size_t n_ = 0;
+    std::vector<std::uint64_t> words_;
+};
+
+// Menor valor de row[j] + penalty[j] para j < n, onde penalty vale 0 nas cidades livres e
+// infinito nas visitadas. Usa AVX ou SSE2 quando o compilador os habilita (-mavx; SSE2 é o
+// padrão em x86-64) e termina o resto do vetor no laço escalar.
+inline double maskedMin(const double* row, const double* penalty, std::size_t n) {
+    double best = std::numeric_limits<double>::infinity();
+    std::size_t j = 0;
+#if defined(__AVX__)
+    __m256d lanes = _mm256_set1_pd(best);
+    for (; j + 4 <= n; j += 4) {
+        lanes = _mm256_min_pd(lanes, _mm256_add_pd(_mm256_loadu_pd(row + j), _mm256_loadu_pd(penalty + j)));
+    }
+    double values[4];
+    _mm256_storeu_pd(values, lanes);
+    for (double value : values) best = std::min(best, value);
+#elif defined(__SSE2__)
+    __m128d lanes = _mm_set1_pd(best);
+    for (; j + 2 <= n; j += 2) {
+        lanes = _mm_min_pd(lanes, _mm_add_pd(_mm_loadu_pd(row + j), _mm_loadu_pd(penalty + j)));
+    }
+    double values[2];
+    _mm_storeu_pd(values, lanes);
+    for (double value : values) best = std::min(best, value);
+#endif
+    for (; j < n; ++j) best = std::min(best, row[j] + penalty[j]);
+    return best;
+}
+
+inline float maskedMin(const float* row, const float* penalty, std::size_t n) {
+    float best = std::numeric_limits<float>::infinity();
+    std::size_t j = 0;
+#if defined(__AVX__)
+    __m256 lanes = _mm256_set1_ps(best);
+    for (; j + 8 <= n; j += 8) {
+        lanes = _mm256_min_ps(lanes, _mm256_add_ps(_mm256_loadu_ps(row + j), _mm256_loadu_ps(penalty + j)));
+    }
+    float values[8];
+    _mm256_storeu_ps(values, lanes);
+    for (float value : values) best = std::min(best, value);
+#elif defined(__SSE2__)
+    __m128 lanes = _mm_set1_ps(best);
+    for (; j + 4 <= n; j += 4) {
+        lanes = _mm_min_ps(lanes, _mm_add_ps(_mm_loadu_ps(row + j), _mm_loadu_ps(penalty + j)));
+    }
+    float values[4];
+    _mm_storeu_ps(values, lanes);
+    for (float value : values) best = std::min(best, value);
+#endif
+    for (; j < n; ++j) best = std::min(best, row[j] + penalty[j]);
+    return best;
+}
+
+// Construção pelo vizinho mais próximo. A partir da cidade atual segue a sua lista de vizinhos
+// ordenada e pega a primeira cidade ainda não visitada (teste em um conjunto de bits); só
+// quando a lista inteira já foi visitada a linha da matriz é varrida: com redução de mínimo em
+// SIMD (matriz float/double no modo completo, metade ou mais das cidades livres) ou percorrendo
+// só os bits das cidades livres. O resultado é o mesmo da varredura completa (menor custo, e a
+// menor cidade em caso de empate): as listas seguem essa mesma ordem.
+// Os buffers são reaproveitados entre chamadas de build, então um construtor por thread basta.
+template <typename T>
+class NearestNeighborBuilder {
+public:
+    NearestNeighborBuilder(const CostMatrix<T>& costMatrix, const NeighborLists* neighbors = nullptr)
+        : cost_(costMatrix), neighbors_(neighbors) {}
+
+    // Rota fechada a partir da cidade inicial (começa e termina nela) e o seu custo
+    std::pair<std::vector<int>, double> build(int start) {
+        std::size_t n = cost_.size();
+        visited_.reset(n);
+        remaining_ = n;
+        if (std::is_floating_point<T>::value) penalty_.assign(n, T(0));
+
+        std::vector<int> route;
+        route.reserve(n + 1);
+        double cost = 0.0;
+
+        int current = start;
+        route.push_back(current);
+        visit(current);
+        for (std::size_t i = 1; i < n; ++i) {
+            int next = nearestUnvisited(current);
+            cost += cost_(current, next);
+            current = next;
+            route.push_back(current);
+            visit(current);
+        }
+
+        cost += cost_(current, start);
+        route.push_back(start);
+        return {route, cost};
+    }
+
+private:
+    void visit(int city) {
+        visited_.set(city);
+        --remaining_;
+        if (std::is_floating_point<T>::value) penalty_[city] = std::numeric_limits<T>::infinity();
+    }
+
+    int nearestUnvisited(int city) {
+        if (neighbors_ != nullptr && !neighbors_->empty()) {
+            for (const int* c = neighbors_->begin(city); c != neighbors_->end(city); ++c) {
+                if (!visited_.test(*c)) return *c;
+            }
+        }
+        return scan(city);
+    }
+
+    // Varredura da linha (lista esgotada ou sem listas)
+    int scan(int city) {
+        std::size_t n = cost_.size();
+        if constexpr (std::is_floating_point<T>::value) {
+            // Linha contígua e ao menos metade das cidades livres: mínimo em SIMD e depois a
+            // primeira cidade livre com esse custo
+            if (!cost_.symmetric() && remaining_ * 2 >= n) {
+                const T* row = cost_.row(city);
+                T best = maskedMin(row, penalty_.data(), n);
+                for (std::size_t j = 0; j < n; ++j) {
+                    if (row[j] == best && !visited_.test(static_cast<int>(j))) return static_cast<int>(j);
+                }
+            }
+        }
+
+        // Poucas cidades livres, modo simétrico, tipos inteiros (ou custos infinitos): só as
+        // cidades livres são lidas
+        int nearest = -1;
+        T nearestCost = T();
+        visited_.forEachUnvisited([&](int j) {
+            T value = cost_(city, j);
+            if (nearest < 0 || value < nearestCost) {
+                nearest = j;
+                nearestCost = value;
+            }
+        });
+        return nearest;
+    }
+
+    const CostMatrix<T>& cost_;
+    const NeighborLists* neighbors_;
+    VisitedSet visited_;
+    std::size_t remaining_ = 0;
+    std::vector<T> penalty_;
+};
+
+#endif
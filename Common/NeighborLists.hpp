@@ -0,0 +1,57 @@
+#ifndef COMMON_NEIGHBORLISTS_HPP
+#define COMMON_NEIGHBORLISTS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+#include "CostMatrix.hpp"
+
+// Listas de candidatos: para cada cidade, as k cidades mais próximas (pelo custo de saída
+// c(i, j)), em ordem crescente de custo. São montadas uma vez por matriz com partial_sort e
+// guardadas em um único vetor contíguo (n * k inteiros).
+class NeighborLists {
+public:
+    NeighborLists() = default;
+
+    template <typename T>
+    NeighborLists(const CostMatrix<T>& costMatrix, std::size_t k) {
+        build(costMatrix, k);
+    }
+
+    template <typename T>
+    void build(const CostMatrix<T>& costMatrix, std::size_t k) {
+        n_ = costMatrix.size();
+        k_ = n_ > 1 ? std::min(k, n_ - 1) : 0;
+        neighbors_.assign(n_ * k_, 0);
+
+        std::vector<int> others(n_ > 0 ? n_ - 1 : 0);
+        for (std::size_t city = 0; city < n_; ++city) {
+            // Todas as outras cidades, ordenadas só até a k-ésima mais próxima
+            std::iota(others.begin(), others.begin() + city, 0);
+            std::iota(others.begin() + city, others.end(), static_cast<int>(city) + 1);
+            std::partial_sort(others.begin(), others.begin() + k_, others.end(), [&](int a, int b) {
+                T costA = costMatrix(city, a);
+                T costB = costMatrix(city, b);
+                return costA < costB || (costA == costB && a < b);
+            });
+            std::copy(others.begin(), others.begin() + k_, neighbors_.begin() + city * k_);
+        }
+    }
+
+    std::size_t size() const { return n_; }
+    std::size_t k() const { return k_; }
+    bool empty() const { return k_ == 0; }
+
+    // Ponteiros para os k vizinhos da cidade, do mais próximo ao mais distante
+    const int* begin(int city) const { return neighbors_.data() + static_cast<std::size_t>(city) * k_; }
+    const int* end(int city) const { return begin(city) + k_; }
+
+private:
+    std::size_t n_ = 0;
+    std::size_t k_ = 0;
+    std::vector<int> neighbors_;
+};
+
+#endif
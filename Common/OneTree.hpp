@@ -0,0 +1,209 @@
+#ifndef COMMON_ONETREE_HPP
+#define COMMON_ONETREE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "CostMatrix.hpp"
+#include "Deadline.hpp"
+
+// Convergência do subgradiente: lambda cai pela metade depois de até ONE_TREE_MAX_PATIENCE
+// iterações sem o limite subir mais que a fração ONE_TREE_STALL_EPSILON, e a subida termina
+// quando lambda passa abaixo de ONE_TREE_MIN_LAMBDA
+constexpr int ONE_TREE_MAX_PATIENCE = 20;
+constexpr double ONE_TREE_STALL_EPSILON = 1e-5;
+constexpr double ONE_TREE_MIN_LAMBDA = 1e-2;
+
+// Situação de uma aresta em um nó do branch-and-bound (matriz n x n, simétrica)
+enum class EdgeState : char { Free, Required, Forbidden };
+
+// Limite inferior de Held e Karp: uma 1-árvore é uma árvore geradora das cidades 1..n-1 mais
+// duas arestas da cidade 0, e toda rota é uma 1-árvore. Com penalidades pi nas cidades, os
+// pesos viram c(i, j) + pi_i + pi_j e o custo da 1-árvore mínima menos 2 soma(pi) continua sendo
+// um limite inferior para qualquer rota. Em matrizes assimétricas usa min(c(i, j), c(j, i)),
+// o que ainda dá um limite válido. A árvore é montada por Prim em O(n²). Com a matriz de
+// situações das arestas, as proibidas ficam de fora e as obrigatórias entram antes de qualquer
+// outra (a árvore é a mínima entre as que contêm todas elas).
+template <typename T>
+class OneTreeBound {
+public:
+    explicit OneTreeBound(const CostMatrix<T>& costMatrix)
+        : cost_(costMatrix), n_(costMatrix.size()), symmetric_(costMatrix.isSymmetric()), degree_(n_),
+          key_(n_), keyRequired_(n_), parent_(n_), inTree_(n_) {}
+
+    double weight(int i, int j) const {
+        return symmetric_ ? cost_(i, j) : std::min<double>(cost_(i, j), cost_(j, i));
+    }
+
+    // Calcula a 1-árvore mínima com as penalidades pi e devolve o limite (infinito se as
+    // restrições de states não admitem 1-árvore)
+    double evaluate(const std::vector<double>& pi, const std::vector<EdgeState>* states = nullptr) {
+        const double infinity = std::numeric_limits<double>::infinity();
+        edges_.clear();
+        std::fill(degree_.begin(), degree_.end(), 0);
+        if (n_ < 3) return infinity;
+        auto state = [&](int i, int j) { return states ? (*states)[i * n_ + j] : EdgeState::Free; };
+
+        // Prim nas cidades 1..n-1, com as obrigatórias antes (comparação lexicográfica)
+        double total = 0.0;
+        std::fill(inTree_.begin(), inTree_.end(), false);
+        std::fill(key_.begin(), key_.end(), infinity);
+        std::fill(keyRequired_.begin(), keyRequired_.end(), false);
+        int current = 1;
+        inTree_[1] = true;
+        for (std::size_t added = 1; added + 1 < n_; ++added) {
+            int next = -1;
+            for (int v = 2; v < static_cast<int>(n_); ++v) {
+                if (inTree_[v]) continue;
+                EdgeState edge = state(current, v);
+                if (edge != EdgeState::Forbidden) {
+                    double w = weight(current, v) + pi[current] + pi[v];
+                    bool required = edge == EdgeState::Required;
+                    if ((required && !keyRequired_[v]) || (required == keyRequired_[v] && w < key_[v])) {
+                        key_[v] = w;
+                        keyRequired_[v] = required;
+                        parent_[v] = current;
+                    }
+                }
+                if (key_[v] < infinity &&
+                    (next < 0 || (keyRequired_[v] && !keyRequired_[next]) ||
+                     (keyRequired_[v] == keyRequired_[next] && key_[v] < key_[next]))) {
+                    next = v;
+                }
+            }
+            if (next < 0) return infinity;
+            inTree_[next] = true;
+            addEdge(parent_[next], next, key_[next], total);
+            current = next;
+        }
+
+        // As duas arestas da cidade 0: obrigatórias primeiro, depois as de menor peso
+        int first = -1, second = -1;
+        auto better = [&](int a, int b) {
+            bool requiredA = state(0, a) == EdgeState::Required, requiredB = state(0, b) == EdgeState::Required;
+            if (requiredA != requiredB) return requiredA;
+            return weight(0, a) + pi[a] < weight(0, b) + pi[b];
+        };
+        for (int v = 1; v < static_cast<int>(n_); ++v) {
+            if (state(0, v) == EdgeState::Forbidden) continue;
+            if (first < 0 || better(v, first)) {
+                second = first;
+                first = v;
+            } else if (second < 0 || better(v, second)) {
+                second = v;
+            }
+        }
+        if (second < 0) return infinity;
+        addEdge(0, first, weight(0, first) + pi[0] + pi[first], total);
+        addEdge(0, second, weight(0, second) + pi[0] + pi[second], total);
+
+        for (double penalty : pi) {
+            total -= 2.0 * penalty;
+        }
+        return total;
+    }
+
+    // Otimização por subgradiente das penalidades (começa do pi recebido): a cada iteração pi_i
+    // anda step * (grau_i - 2), step = lambda (upperBound - limite) / soma((grau - 2)²), e lambda
+    // cai pela metade depois de patience iterações sem melhora relevante. Para ao achar uma
+    // 1-árvore que é rota, um limite acima de stopAbove ou quando lambda fica pequeno demais (o
+    // limite parou de subir). Devolve o melhor limite; pi e a árvore ficam os dele. Com prazo,
+    // para nele com o melhor limite até ali (menos infinito se não houve tempo para nenhum).
+    double ascend(std::vector<double>& pi, double upperBound, int iterations,
+                  const std::vector<EdgeState>* states = nullptr,
+                  double stopAbove = std::numeric_limits<double>::infinity(), const Deadline* deadline = nullptr) {
+        double best = -std::numeric_limits<double>::infinity();
+        bestPi_ = pi;
+        double lambda = 2.0;
+        int patience = std::min(std::max(5, iterations / 10), ONE_TREE_MAX_PATIENCE), sinceImprovement = 0;
+        for (int iteration = 0; iteration < iterations; ++iteration) {
+            if (expired(deadline)) {
+                if (iteration == 0) return -std::numeric_limits<double>::infinity();
+                break;
+            }
+            double bound = evaluate(pi, states);
+            if (std::isinf(bound)) return bound;
+            bool improved = bound > best + ONE_TREE_STALL_EPSILON * std::abs(best);
+            if (bound > best || isTour()) {
+                best = bound;
+                bestPi_ = pi;
+            }
+            if (improved) {
+                sinceImprovement = 0;
+            } else if (++sinceImprovement >= patience) {
+                lambda /= 2.0;
+                sinceImprovement = 0;
+                if (lambda < ONE_TREE_MIN_LAMBDA) break;
+            }
+            if (isTour() || best > stopAbove) break;
+
+            double norm = 0.0;
+            for (std::size_t v = 0; v < n_; ++v) {
+                norm += (degree_[v] - 2) * (degree_[v] - 2);
+            }
+            double gap = std::isinf(upperBound) ? 0.01 * std::abs(bound) : upperBound - bound;
+            double step = lambda * std::max(gap, 1e-9 * std::abs(bound)) / norm;
+            for (std::size_t v = 0; v < n_; ++v) {
+                pi[v] += step * (degree_[v] - 2);
+            }
+        }
+        pi = bestPi_;
+        return evaluate(pi, states);
+    }
+
+    // A 1-árvore da última avaliação
+    const std::vector<std::pair<int, int>>& edges() const { return edges_; }
+    const std::vector<int>& degree() const { return degree_; }
+
+    // Se todas as cidades têm grau 2, a 1-árvore é uma rota (e o limite é o custo dela)
+    bool isTour() const {
+        if (edges_.size() != n_) return false;
+        for (int d : degree_) {
+            if (d != 2) return false;
+        }
+        return true;
+    }
+
+    // A rota da 1-árvore (ciclo a partir da cidade 0); só vale se isTour()
+    std::vector<int> tour() const {
+        std::vector<std::vector<int>> adjacent(n_);
+        for (const auto& edge : edges_) {
+            adjacent[edge.first].push_back(edge.second);
+            adjacent[edge.second].push_back(edge.first);
+        }
+        std::vector<int> route = {0};
+        int previous = 0, city = adjacent[0][0];
+        while (city != 0) {
+            route.push_back(city);
+            int next = adjacent[city][0] == previous ? adjacent[city][1] : adjacent[city][0];
+            previous = city;
+            city = next;
+        }
+        return route;
+    }
+
+private:
+    void addEdge(int a, int b, double w, double& total) {
+        edges_.emplace_back(a, b);
+        ++degree_[a];
+        ++degree_[b];
+        total += w;
+    }
+
+    const CostMatrix<T>& cost_;
+    std::size_t n_;
+    bool symmetric_;
+    std::vector<std::pair<int, int>> edges_;
+    std::vector<int> degree_;
+    std::vector<double> key_;
+    std::vector<char> keyRequired_;
+    std::vector<int> parent_;
+    std::vector<char> inTree_;
+    std::vector<double> bestPi_;
+};
+
+#endif
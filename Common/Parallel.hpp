@@ -0,0 +1,110 @@
+#ifndef COMMON_PARALLEL_HPP
+#define COMMON_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Número de threads padrão: os núcleos da máquina (ao menos 1)
+inline int defaultThreadCount() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Executa body(index, threadId) para cada index em [0, count) com numThreads threads.
+// As threads pegam o próximo índice de um contador atômico compartilhado, então tarefas de
+// duração desigual ficam balanceadas; threadId (0..numThreads-1) permite que cada thread use
+// os seus próprios buffers. Com uma thread tudo roda na thread atual.
+template <typename Body>
+void parallelFor(std::size_t count, int numThreads, Body body) {
+    numThreads = static_cast<int>(std::max<std::size_t>(1, std::min<std::size_t>(numThreads, count)));
+    std::atomic<std::size_t> nextIndex(0);
+
+    auto worker = [&](int threadId) {
+        for (std::size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed); index < count;
+             index = nextIndex.fetch_add(1, std::memory_order_relaxed)) {
+            body(index, threadId);
+        }
+    };
+
+    if (numThreads == 1) {
+        worker(0);
+        return;
+    }
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+
+// Processa tarefas que criam novas tarefas (como os nós de uma busca em árvore) com roubo de
+// trabalho: cada thread tem a sua fila e pega sempre a tarefa mais recente dela (busca em
+// profundidade); sem trabalho, rouba a mais antiga da fila de outra thread, que costuma ser a
+// raiz de uma subárvore grande. body(task, threadId, push) processa a tarefa e chama
+// push(novaTarefa) para colocar tarefas na fila da thread. Termina quando nenhuma tarefa está
+// nas filas nem em execução.
+template <typename Task, typename Body>
+void parallelExplore(std::vector<Task> initial, int numThreads, Body body) {
+    numThreads = std::max(1, numThreads);
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+    std::vector<Queue> queues(numThreads);
+    for (std::size_t i = 0; i < initial.size(); ++i) {
+        queues[i % numThreads].tasks.push_back(std::move(initial[i]));
+    }
+    std::atomic<std::size_t> pending(initial.size());
+
+    auto worker = [&](int threadId) {
+        auto push = [&](Task task) {
+            pending.fetch_add(1);
+            std::lock_guard<std::mutex> lock(queues[threadId].mutex);
+            queues[threadId].tasks.push_back(std::move(task));
+        };
+        while (pending.load() > 0) {
+            Task task;
+            bool found = false;
+            for (int k = 0; k < numThreads && !found; ++k) {
+                Queue& queue = queues[(threadId + k) % numThreads];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (queue.tasks.empty()) continue;
+                if (k == 0) {
+                    task = std::move(queue.tasks.back());
+                    queue.tasks.pop_back();
+                } else {
+                    task = std::move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                }
+                found = true;
+            }
+            if (!found) {
+                std::this_thread::yield();
+                continue;
+            }
+            body(task, threadId, push);
+            pending.fetch_sub(1);
+        }
+    };
+
+    if (numThreads == 1) {
+        worker(0);
+        return;
+    }
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+
+#endif
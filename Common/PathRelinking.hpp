@@ -0,0 +1,180 @@
+#ifndef COMMON_PATHRELINKING_HPP
+#define COMMON_PATHRELINKING_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <vector>
+
+#include "CostMatrix.hpp"
+#include "LocalSearch.hpp"
+
+// Sentido da religação de caminhos entre uma solução nova e uma solução da elite
+enum class RelinkingMode {
+    None,
+    Forward,  // Parte da solução nova em direção à elite
+    Backward, // Parte da elite em direção à solução nova
+    Mixed     // Alterna um passo de cada ponta até as duas se encontrarem
+};
+
+struct PathRelinkingOptions {
+    RelinkingMode mode = RelinkingMode::None;
+    std::size_t eliteSize = 10;   // Número máximo de soluções na elite
+    double minDistance = 0.1;     // Distância mínima para entrar na elite, em fração das arestas
+};
+
+// Número de arestas da rota a (ciclo) que não estão na rota b. Em matrizes simétricas a aresta
+// vale nos dois sentidos.
+inline std::size_t edgeDistance(const std::vector<int>& a, const std::vector<int>& b, bool symmetric) {
+    std::size_t n = a.size();
+    std::vector<int> successor(n), predecessor(n);
+    for (std::size_t p = 0; p < n; ++p) {
+        successor[b[p]] = b[(p + 1) % n];
+        predecessor[b[(p + 1) % n]] = b[p];
+    }
+    std::size_t distance = 0;
+    for (std::size_t p = 0; p < n; ++p) {
+        int x = a[p], y = a[(p + 1) % n];
+        if (successor[x] != y && !(symmetric && predecessor[x] == y)) ++distance;
+    }
+    return distance;
+}
+
+// Conjunto de soluções de elite, compartilhado entre as threads (acesso protegido por mutex).
+// Uma rota a menos de minDistance arestas de uma solução da elite só entra no lugar dela e se
+// for melhor; uma rota diferente de todas entra se houver espaço ou no lugar da pior, se for
+// melhor que ela.
+class ElitePool {
+public:
+    ElitePool(std::size_t capacity, std::size_t minDistance, bool symmetric)
+        : capacity_(std::max<std::size_t>(1, capacity)), minDistance_(std::max<std::size_t>(1, minDistance)),
+          symmetric_(symmetric) {}
+
+    // Tenta incluir a rota; devolve true se ela entrou na elite
+    bool tryAdd(const std::vector<int>& route, double cost) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::size_t closest = members_.size();
+        std::size_t closestDistance = std::numeric_limits<std::size_t>::max();
+        std::size_t worst = members_.size();
+        for (std::size_t i = 0; i < members_.size(); ++i) {
+            std::size_t distance = edgeDistance(route, members_[i].route, symmetric_);
+            if (distance < closestDistance) {
+                closestDistance = distance;
+                closest = i;
+            }
+            if (worst == members_.size() || members_[i].cost > members_[worst].cost) worst = i;
+        }
+
+        if (closestDistance < minDistance_) {
+            if (cost >= members_[closest].cost - IMPROVEMENT_EPSILON) return false;
+            members_[closest] = {route, cost};
+        } else if (members_.size() < capacity_) {
+            members_.push_back({route, cost});
+        } else if (cost < members_[worst].cost - IMPROVEMENT_EPSILON) {
+            members_[worst] = {route, cost};
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    // Copia uma solução sorteada da elite; devolve false se a elite estiver vazia
+    bool sample(std::mt19937& generator, std::vector<int>& route, double& cost) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (members_.empty()) return false;
+        std::uniform_int_distribution<std::size_t> distribution(0, members_.size() - 1);
+        const Member& member = members_[distribution(generator)];
+        route = member.route;
+        cost = member.cost;
+        return true;
+    }
+
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return members_.size();
+    }
+
+private:
+    struct Member {
+        std::vector<int> route;
+        double cost;
+    };
+
+    std::size_t capacity_;
+    std::size_t minDistance_;
+    bool symmetric_;
+    mutable std::mutex mutex_;
+    std::vector<Member> members_;
+};
+
+// Religação de caminhos entre duas rotas (ciclos). As duas são giradas para começar na cidade 0
+// (e, em matrizes simétricas, a guia é invertida se isso alinhar mais posições). A cada passo a
+// rota que anda coloca em uma posição divergente a cidade que a outra tem ali, por uma troca de
+// duas cidades; entre as posições divergentes é escolhida a troca de menor custo (avaliada em
+// O(1)). Devolve a melhor solução intermediária em best e o seu custo (infinito se as rotas
+// forem vizinhas demais para haver solução intermediária).
+template <typename T>
+double pathRelink(const std::vector<int>& start, const std::vector<int>& guide, const CostMatrix<T>& costMatrix,
+                  RelinkingMode mode, std::vector<int>& best) {
+    double bestCost = std::numeric_limits<double>::infinity();
+    std::size_t n = start.size();
+    if (mode == RelinkingMode::None || n < 5 || guide.size() != n) return bestCost;
+
+    std::vector<int> a(start), b(guide);
+    std::rotate(a.begin(), std::find(a.begin(), a.end(), 0), a.end());
+    std::rotate(b.begin(), std::find(b.begin(), b.end(), 0), b.end());
+    if (costMatrix.symmetric() || costMatrix.isSymmetric()) {
+        std::vector<int> reversed(b);
+        std::reverse(reversed.begin() + 1, reversed.end());
+        std::size_t matches = 0, reversedMatches = 0;
+        for (std::size_t p = 1; p < n; ++p) {
+            matches += a[p] == b[p];
+            reversedMatches += a[p] == reversed[p];
+        }
+        if (reversedMatches > matches) b.swap(reversed);
+    }
+
+    RouteState stateA(a), stateB(b);
+    double costA = cycleCost(a, costMatrix), costB = cycleCost(b, costMatrix);
+
+    bool moveA = mode != RelinkingMode::Backward;
+    while (true) {
+        std::vector<int>& moving = moveA ? a : b;
+        const std::vector<int>& target = moveA ? b : a;
+        RouteState& state = moveA ? stateA : stateB;
+        double& cost = moveA ? costA : costB;
+
+        std::size_t differences = 0;
+        double bestDelta = std::numeric_limits<double>::infinity();
+        std::size_t bestPosition = 0;
+        for (std::size_t p = 1; p < n; ++p) {
+            if (moving[p] == target[p]) continue;
+            ++differences;
+            double delta = swapDelta(state, costMatrix, moving[p], target[p]);
+            if (delta < bestDelta) {
+                bestDelta = delta;
+                bestPosition = p;
+            }
+        }
+        if (differences == 0) break;
+
+        int placed = target[bestPosition];
+        std::size_t from = state.position(placed);
+        state.swapCities(moving[bestPosition], placed);
+        cost += bestDelta;
+
+        // A troca acerta uma ou duas posições; se acertou as últimas, a rota chegou à outra ponta
+        differences -= moving[from] == target[from] ? 2 : 1;
+        if (differences == 0) break;
+        if (cost < bestCost) {
+            bestCost = cost;
+            best = moving;
+        }
+        if (mode == RelinkingMode::Mixed) moveA = !moveA;
+    }
+    return bestCost;
+}
+
+#endif
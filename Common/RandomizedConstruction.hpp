@@ -0,0 +1,124 @@
+#ifndef COMMON_RANDOMIZEDCONSTRUCTION_HPP
+#define COMMON_RANDOMIZEDCONSTRUCTION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "CostMatrix.hpp"
+#include "NeighborLists.hpp"
+
+// Critério da lista restrita de candidatos (RCL)
+enum class RclMode {
+    Value,      // Candidatos com custo <= mínimo + alpha * (máximo - mínimo)
+    Cardinality // Os size candidatos mais baratos
+};
+
+struct RclOptions {
+    RclMode mode = RclMode::Value;
+    std::size_t size = 3;                     // Tamanho da RCL no modo Cardinality
+    const NeighborLists* candidates = nullptr; // Se houver, a RCL só considera as cidades da lista
+};
+
+// Construção aleatória-gulosa do GRASP a partir da cidade 0: a cada passo sorteia a próxima
+// cidade na RCL montada a partir da cidade atual. As cidades não visitadas ficam em um vetor
+// denso (remoção trocando com a última), então cada passo percorre só as cidades livres: uma
+// passada acha o mínimo e o máximo e outra filtra a RCL para um buffer reaproveitado (no modo
+// Cardinality, nth_element separa os size mais baratos). Com listas de candidatos, só as
+// vizinhas livres da cidade atual são consideradas, e todas as livres quando a lista se esgota.
+// Os buffers são reaproveitados entre chamadas de build, então um construtor por thread basta.
+template <typename T>
+class GreedyRandomizedBuilder {
+public:
+    GreedyRandomizedBuilder(const CostMatrix<T>& costMatrix, const RclOptions& options = RclOptions())
+        : cost_(costMatrix), options_(options) {}
+
+    // Grava a rota (aberta, começando na cidade 0) em route
+    void build(std::vector<int>& route, double alpha, std::mt19937& generator) {
+        int n = static_cast<int>(cost_.size());
+        route.clear();
+        if (n == 0) return;
+        unvisited_.resize(n);
+        slot_.resize(n);
+        for (int city = 0; city < n; ++city) {
+            unvisited_[city] = city;
+            slot_[city] = city;
+        }
+        remaining_ = n;
+
+        int current = 0;
+        route.push_back(current);
+        visit(current);
+        while (remaining_ > 0) {
+            collectCandidates(current);
+            selectRcl(alpha);
+            std::uniform_int_distribution<std::size_t> distribution(0, rclSize_ - 1);
+            current = candidates_[distribution(generator)].second;
+            route.push_back(current);
+            visit(current);
+        }
+    }
+
+private:
+    bool isVisited(int city) const { return slot_[city] >= remaining_; }
+
+    void visit(int city) {
+        int last = unvisited_[--remaining_];
+        int slot = slot_[city];
+        unvisited_[slot] = last;
+        slot_[last] = slot;
+        unvisited_[remaining_] = city;
+        slot_[city] = remaining_;
+    }
+
+    // Cidades livres que podem entrar na RCL, com o custo a partir da cidade atual
+    void collectCandidates(int current) {
+        candidates_.clear();
+        const NeighborLists* lists = options_.candidates;
+        if (lists != nullptr && !lists->empty()) {
+            for (const int* c = lists->begin(current); c != lists->end(current); ++c) {
+                if (!isVisited(*c)) candidates_.emplace_back(cost_(current, *c), *c);
+            }
+            if (!candidates_.empty()) return;
+        }
+        for (int k = 0; k < remaining_; ++k) {
+            int city = unvisited_[k];
+            candidates_.emplace_back(cost_(current, city), city);
+        }
+    }
+
+    // Deixa a RCL nas primeiras rclSize_ posições de candidates_
+    void selectRcl(double alpha) {
+        if (options_.mode == RclMode::Cardinality) {
+            rclSize_ = std::min(std::max<std::size_t>(options_.size, 1), candidates_.size());
+            std::nth_element(candidates_.begin(), candidates_.begin() + (rclSize_ - 1), candidates_.end());
+            return;
+        }
+
+        T minCost = candidates_.front().first;
+        T maxCost = minCost;
+        for (const auto& candidate : candidates_) {
+            minCost = std::min(minCost, candidate.first);
+            maxCost = std::max(maxCost, candidate.first);
+        }
+        double threshold = minCost + alpha * (static_cast<double>(maxCost) - minCost);
+
+        // Move para o início os candidatos dentro do limiar (o de custo mínimo sempre entra)
+        rclSize_ = 0;
+        for (std::size_t k = 0; k < candidates_.size(); ++k) {
+            if (candidates_[k].first <= threshold) std::swap(candidates_[rclSize_++], candidates_[k]);
+        }
+    }
+
+    const CostMatrix<T>& cost_;
+    RclOptions options_;
+    std::vector<int> unvisited_; // Cidades livres nas posições [0, remaining_)
+    std::vector<int> slot_;      // Posição de cada cidade em unvisited_
+    int remaining_ = 0;
+    std::vector<std::pair<T, int>> candidates_;
+    std::size_t rclSize_ = 0;
+};
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef COMMON_REACTIVEALPHA_HPP
+#define COMMON_REACTIVEALPHA_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Estatísticas de um valor de alpha do GRASP reativo
+struct AlphaStats {
+    double alpha = 0.0;
+    int iterations = 0;
+    double costSum = 0.0;
+    double bestCost = std::numeric_limits<double>::infinity();
+    double probability = 0.0;
+
+    double averageCost() const { return iterations > 0 ? costSum / iterations : 0.0; }
+};
+
+// Escolha reativa de alpha (Prais e Ribeiro): alpha é sorteado de um conjunto discreto com
+// probabilidades p_i = q_i / soma(q), q_i = (melhor custo / custo médio de alpha_i)^amplification.
+// As probabilidades começam uniformes e são recalculadas a cada updatePeriod soluções; um alpha
+// ainda não sorteado recebe q_i = 1, o maior valor possível, para ser experimentado.
+class ReactiveAlpha {
+public:
+    explicit ReactiveAlpha(const std::vector<double>& alphas = {0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9},
+                           int updatePeriod = 10, double amplification = 10.0)
+        : updatePeriod_(std::max(1, updatePeriod)), amplification_(amplification) {
+        for (double alpha : alphas) {
+            AlphaStats entry;
+            entry.alpha = alpha;
+            entry.probability = 1.0 / alphas.size();
+            stats_.push_back(entry);
+        }
+    }
+
+    const std::vector<AlphaStats>& stats() const { return stats_; }
+
+    // Zera as estatísticas e volta às probabilidades uniformes (mesmos alphas e parâmetros)
+    void clearStats() {
+        for (AlphaStats& entry : stats_) {
+            entry = AlphaStats{entry.alpha, 0, 0.0, std::numeric_limits<double>::infinity(), 1.0 / stats_.size()};
+        }
+        sinceUpdate_ = 0;
+        bestCost_ = std::numeric_limits<double>::infinity();
+    }
+
+    // Índice do alpha da próxima construção
+    std::size_t choose(std::mt19937& generator) const {
+        std::uniform_real_distribution<double> distribution(0.0, 1.0);
+        double draw = distribution(generator);
+        for (std::size_t i = 0; i + 1 < stats_.size(); ++i) {
+            draw -= stats_[i].probability;
+            if (draw < 0.0) return i;
+        }
+        return stats_.size() - 1;
+    }
+
+    double alpha(std::size_t index) const { return stats_[index].alpha; }
+
+    // Registra o custo da solução (depois da busca local) obtida com o alpha escolhido
+    void record(std::size_t index, double cost) {
+        AlphaStats& entry = stats_[index];
+        ++entry.iterations;
+        entry.costSum += cost;
+        entry.bestCost = std::min(entry.bestCost, cost);
+        bestCost_ = std::min(bestCost_, cost);
+        if (++sinceUpdate_ >= updatePeriod_) {
+            sinceUpdate_ = 0;
+            updateProbabilities();
+        }
+    }
+
+    // Soma as estatísticas de outra instância com os mesmos alphas (uma por thread) e recalcula
+    // as probabilidades com o total
+    void merge(const ReactiveAlpha& other) {
+        for (std::size_t i = 0; i < stats_.size() && i < other.stats_.size(); ++i) {
+            stats_[i].iterations += other.stats_[i].iterations;
+            stats_[i].costSum += other.stats_[i].costSum;
+            stats_[i].bestCost = std::min(stats_[i].bestCost, other.stats_[i].bestCost);
+        }
+        bestCost_ = std::min(bestCost_, other.bestCost_);
+        updateProbabilities();
+    }
+
+private:
+    void updateProbabilities() {
+        double total = 0.0;
+        for (AlphaStats& entry : stats_) {
+            double average = entry.averageCost();
+            entry.probability = entry.iterations > 0 && average > 0.0 ? std::pow(bestCost_ / average, amplification_) : 1.0;
+            total += entry.probability;
+        }
+        for (AlphaStats& entry : stats_) {
+            entry.probability /= total;
+        }
+    }
+
+    std::vector<AlphaStats> stats_;
+    int updatePeriod_;
+    double amplification_;
+    int sinceUpdate_ = 0;
+    double bestCost_ = std::numeric_limits<double>::infinity();
+};
+
+#endif
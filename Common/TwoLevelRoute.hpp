@@ -0,0 +1,315 @@
+#ifndef COMMON_TWOLEVELROUTE_HPP
+#define COMMON_TWOLEVELROUTE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+// A partir deste número de cidades a busca local usa a lista de dois níveis no lugar do vetor
+constexpr std::size_t TWO_LEVEL_MIN_CITIES = 1000;
+
+// Rota em lista de dois níveis, com a mesma interface de RouteState (posições cíclicas, next,
+// prev, reverse...). A rota é dividida em cerca de sqrt(n) segmentos consecutivos; cada
+// segmento guarda suas cidades em um vetor, um bit de inversão, sua ordem (rank) entre os
+// segmentos e a posição da sua primeira cidade na rota. next, prev, position e between são
+// O(1) e at é O(log n). Inverter um trecho curto troca as cidades uma a uma; um trecho longo
+// é alinhado às fronteiras dos segmentos (movendo no máximo meio segmento de cada ponta) e
+// então só a ordem e os bits dos segmentos são invertidos: O(sqrt(n)) por inversão.
+class TwoLevelRoute {
+public:
+    explicit TwoLevelRoute(const std::vector<int>& route) { build(route); }
+
+    std::size_t size() const { return n_; }
+
+    // Contador de alterações da rota (muda a cada inversão ou troca)
+    std::size_t version() const { return version_; }
+
+    // Grava a rota atual no vetor, cada cidade na sua posição
+    void store(std::vector<int>& route) const {
+        route.resize(n_);
+        for (std::size_t city = 0; city < n_; ++city) {
+            route[position(static_cast<int>(city))] = static_cast<int>(city);
+        }
+    }
+
+    // Cidade na posição p (com p tomado de forma cíclica): busca binária pelo segmento
+    int at(std::size_t p) const {
+        p %= n_;
+        std::size_t base = segments_[order_[0]].start;
+        std::size_t target = (p + n_ - base) % n_;
+        std::size_t low = 0, high = order_.size() - 1;
+        while (low < high) {
+            std::size_t middle = (low + high + 1) / 2;
+            if ((segments_[order_[middle]].start + n_ - base) % n_ <= target) {
+                low = middle;
+            } else {
+                high = middle - 1;
+            }
+        }
+        const Segment& segment = segments_[order_[low]];
+        std::size_t offset = (p + n_ - segment.start) % n_;
+        return segment.cities[segment.reversed ? segment.cities.size() - 1 - offset : offset];
+    }
+
+    std::size_t position(int city) const {
+        const Segment& segment = segments_[segment_[city]];
+        return (segment.start + offsetOf(city)) % n_;
+    }
+
+    int next(int city) const {
+        const Segment& segment = segments_[segment_[city]];
+        std::size_t i = index_[city];
+        if (!segment.reversed) {
+            if (i + 1 < segment.cities.size()) return segment.cities[i + 1];
+        } else if (i > 0) {
+            return segment.cities[i - 1];
+        }
+        return head(segments_[order_[(segment.rank + 1) % order_.size()]]);
+    }
+
+    int prev(int city) const {
+        const Segment& segment = segments_[segment_[city]];
+        std::size_t i = index_[city];
+        if (!segment.reversed) {
+            if (i > 0) return segment.cities[i - 1];
+        } else if (i + 1 < segment.cities.size()) {
+            return segment.cities[i + 1];
+        }
+        return tail(segments_[order_[(segment.rank + order_.size() - 1) % order_.size()]]);
+    }
+
+    // Número de posições de from até to, andando para frente (inclusive)
+    std::size_t span(std::size_t from, std::size_t to) const { return (to + n_ - from) % n_ + 1; }
+
+    // Verifica se b está no caminho que vai de a até c andando para frente
+    bool between(int a, int b, int c) const {
+        std::size_t pa = position(a);
+        return span(pa, position(b)) <= span(pa, position(c));
+    }
+
+    // Inverte o trecho cíclico que vai da posição from até a posição to (inclusive); as cidades
+    // fora do trecho não mudam de posição
+    void reverse(std::size_t from, std::size_t to) {
+        std::size_t length = span(from, to);
+        if (length < 2) return;
+        ++version_;
+
+        if (length <= groupSize_) {
+            int left = at(from);
+            int right = at(to);
+            for (std::size_t k = 0; k < length / 2; ++k) {
+                int nextLeft = next(left);
+                int prevRight = prev(right);
+                swapCities(left, right);
+                left = nextLeft;
+                right = prevRight;
+            }
+            return;
+        }
+
+        int first = at(from);
+        int last = at(to);
+        splitBefore(first);
+        splitAfter(last, first);
+
+        // O trecho agora é formado por segmentos inteiros: inverte a ordem e os bits deles
+        std::size_t m = order_.size();
+        std::size_t firstRank = segments_[segment_[first]].rank;
+        std::size_t lastRank = segments_[segment_[last]].rank;
+        std::size_t count = (lastRank + m - firstRank) % m + 1;
+        for (std::size_t k = 0; k < count / 2; ++k) {
+            std::swap(order_[(firstRank + k) % m], order_[(lastRank + m - k) % m]);
+        }
+        std::size_t start = from % n_;
+        for (std::size_t k = 0; k < count; ++k) {
+            std::size_t rank = (firstRank + k) % m;
+            Segment& segment = segments_[order_[rank]];
+            segment.rank = rank;
+            segment.reversed = !segment.reversed;
+            segment.start = start;
+            start = (start + segment.cities.size()) % n_;
+        }
+
+        if (needsRebuild_) {
+            std::vector<int> route;
+            store(route);
+            build(route);
+        }
+    }
+
+    // Troca de lugar os trechos adjacentes [from, middle] e [middle+1, to] (três inversões)
+    void swapAdjacentSegments(std::size_t from, std::size_t middle, std::size_t to) {
+        reverse(from, middle);
+        reverse((middle + 1) % n_, to);
+        reverse(from, to);
+    }
+
+    // Troca duas cidades de posição
+    void swapCities(int a, int b) {
+        ++version_;
+        segments_[segment_[a]].cities[index_[a]] = b;
+        segments_[segment_[b]].cities[index_[b]] = a;
+        std::swap(segment_[a], segment_[b]);
+        std::swap(index_[a], index_[b]);
+    }
+
+private:
+    struct Segment {
+        std::vector<int> cities; // Cidades na ordem em que foram gravadas
+        bool reversed = false;   // Se true, o segmento é percorrido de trás para frente
+        std::size_t rank = 0;    // Ordem do segmento na rota
+        std::size_t start = 0;   // Posição da primeira cidade (no sentido da rota)
+    };
+
+    void build(const std::vector<int>& route) {
+        n_ = route.size();
+        groupSize_ = std::max<std::size_t>(8, static_cast<std::size_t>(std::sqrt(static_cast<double>(n_))));
+        std::size_t m = std::max<std::size_t>(2, (n_ + groupSize_ - 1) / groupSize_);
+        m = std::min(m, n_);
+
+        segments_.assign(m, Segment());
+        order_.resize(m);
+        std::iota(order_.begin(), order_.end(), 0);
+        segment_.resize(n_);
+        index_.resize(n_);
+        for (std::size_t s = 0; s < m; ++s) {
+            std::size_t begin = n_ * s / m;
+            std::size_t end = n_ * (s + 1) / m;
+            segments_[s].rank = s;
+            segments_[s].start = begin;
+            segments_[s].cities.assign(route.begin() + begin, route.begin() + end);
+            reindex(static_cast<int>(s));
+        }
+        needsRebuild_ = false;
+    }
+
+    static int head(const Segment& segment) { return segment.reversed ? segment.cities.back() : segment.cities.front(); }
+    static int tail(const Segment& segment) { return segment.reversed ? segment.cities.front() : segment.cities.back(); }
+
+    // Distância da cidade até o início do seu segmento, no sentido da rota
+    std::size_t offsetOf(int city) const {
+        const Segment& segment = segments_[segment_[city]];
+        return segment.reversed ? segment.cities.size() - 1 - index_[city] : index_[city];
+    }
+
+    void reindex(int s) {
+        const std::vector<int>& cities = segments_[s].cities;
+        for (std::size_t i = 0; i < cities.size(); ++i) {
+            segment_[cities[i]] = s;
+            index_[cities[i]] = i;
+        }
+    }
+
+    // Tira os count primeiros (ou últimos) elementos do segmento, no sentido da rota
+    std::vector<int> takeFront(int s, std::size_t count) {
+        Segment& segment = segments_[s];
+        std::vector<int> piece;
+        if (!segment.reversed) {
+            piece.assign(segment.cities.begin(), segment.cities.begin() + count);
+            segment.cities.erase(segment.cities.begin(), segment.cities.begin() + count);
+        } else {
+            piece.assign(segment.cities.rbegin(), segment.cities.rbegin() + count);
+            segment.cities.resize(segment.cities.size() - count);
+        }
+        reindex(s);
+        segment.start = (segment.start + count) % n_;
+        return piece;
+    }
+
+    std::vector<int> takeBack(int s, std::size_t count) {
+        Segment& segment = segments_[s];
+        std::vector<int> piece;
+        if (!segment.reversed) {
+            piece.assign(segment.cities.end() - count, segment.cities.end());
+            segment.cities.resize(segment.cities.size() - count);
+        } else {
+            piece.assign(segment.cities.begin(), segment.cities.begin() + count);
+            std::reverse(piece.begin(), piece.end());
+            segment.cities.erase(segment.cities.begin(), segment.cities.begin() + count);
+            reindex(s);
+        }
+        return piece;
+    }
+
+    // Acrescenta o trecho (no sentido da rota) no fim ou no começo do segmento
+    void appendBack(int s, const std::vector<int>& piece) {
+        Segment& segment = segments_[s];
+        if (!segment.reversed) {
+            segment.cities.insert(segment.cities.end(), piece.begin(), piece.end());
+        } else {
+            segment.cities.insert(segment.cities.begin(), piece.rbegin(), piece.rend());
+        }
+        reindex(s);
+        checkSize(s);
+    }
+
+    void appendFront(int s, const std::vector<int>& piece) {
+        Segment& segment = segments_[s];
+        if (!segment.reversed) {
+            segment.cities.insert(segment.cities.begin(), piece.begin(), piece.end());
+        } else {
+            segment.cities.insert(segment.cities.end(), piece.rbegin(), piece.rend());
+        }
+        reindex(s);
+        segment.start = (segment.start + n_ - piece.size()) % n_;
+        checkSize(s);
+    }
+
+    // Segmentos muito grandes deixam as inversões lentas: a estrutura é refeita depois da inversão
+    void checkSize(int s) {
+        if (segments_[s].cities.size() > 2 * groupSize_) needsRebuild_ = true;
+    }
+
+    int nextSegment(int s) const { return order_[(segments_[s].rank + 1) % order_.size()]; }
+    int prevSegment(int s) const { return order_[(segments_[s].rank + order_.size() - 1) % order_.size()]; }
+
+    // Faz a cidade ser a primeira do seu segmento, movendo o menor dos dois pedaços para o
+    // segmento vizinho
+    void splitBefore(int city) {
+        int s = segment_[city];
+        std::size_t offset = offsetOf(city);
+        if (offset == 0) return;
+        std::size_t size = segments_[s].cities.size();
+        if (offset <= size - offset) {
+            appendBack(prevSegment(s), takeFront(s, offset));
+        } else {
+            appendFront(nextSegment(s), takeBack(s, size - offset));
+        }
+    }
+
+    // Faz a cidade ser a última do seu segmento sem tirar first do início do seu segmento
+    void splitAfter(int city, int first) {
+        int s = segment_[city];
+        std::size_t offset = offsetOf(city);
+        std::size_t size = segments_[s].cities.size();
+        if (offset + 1 == size) return;
+
+        bool moveBack;
+        if (s == segment_[first]) {
+            moveBack = true; // O pedaço da frente contém first
+        } else if (nextSegment(s) == segment_[first]) {
+            moveBack = false; // O segmento seguinte começa em first
+        } else {
+            moveBack = size - offset - 1 <= offset + 1;
+        }
+        if (moveBack) {
+            appendFront(nextSegment(s), takeBack(s, size - offset - 1));
+        } else {
+            appendBack(prevSegment(s), takeFront(s, offset + 1));
+        }
+    }
+
+    std::size_t n_ = 0;
+    std::size_t groupSize_ = 0;
+    bool needsRebuild_ = false;
+    std::size_t version_ = 0;
+    std::vector<Segment> segments_;
+    std::vector<int> order_;            // Segmentos na ordem da rota
+    std::vector<int> segment_;          // Segmento de cada cidade
+    std::vector<std::size_t> index_;    // Índice de cada cidade no vetor do seu segmento
+};
+
+#endif
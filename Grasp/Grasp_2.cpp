@@ -1,47 +1,20 @@
 #include <iostream>
 #include <vector>
 #include <fstream>
-#include <sstream>
 #include <string>
 #include <algorithm>
 #include <limits>
 #include <chrono>
 
+#include "../Common/CostMatrix.hpp"
+#include "../Common/BinaryMatrix.hpp"
+#include "../Common/LocalSearch.hpp"
+#include "../Common/LowerBound.hpp"
+
 using namespace std;
 using namespace chrono; // Para facilitar o uso das funções de tempo
 
-typedef vector<vector<double>> Matrix;
-
-// Função para carregar a matriz de custos de um arquivo CSV
-Matrix loadMatrixFromCSV(const string& filePath) {
-    Matrix matrix;
-    ifstream file(filePath);
-
-    if (!file.is_open()) {
-        cerr << "Erro ao abrir o arquivo: " << filePath << endl;
-        return matrix;
-    }
-
-    string line;
-    while (getline(file, line)) {
-        vector<double> row;
-        stringstream ss(line);
-        string value;
-
-        while (getline(ss, value, ',')) { // Usa vírgula como separador
-            try {
-                row.push_back(stod(value)); // Converte o valor para double
-            } catch (const invalid_argument&) {
-                row.push_back(0); // Adiciona 0 caso não consiga converter
-            }
-        }
-
-        matrix.push_back(row);
-    }
-
-    file.close();
-    return matrix;
-}
+typedef CostMatrix<COST_TYPE> Matrix;
 
 // Função para carregar os nomes das cidades de um arquivo CSV
 vector<string> loadCitiesFromCSV(const string& filePath) {
@@ -68,39 +41,23 @@ vector<string> loadCitiesFromCSV(const string& filePath) {
 double calculateRouteCost(const vector<int>& route, const Matrix& costMatrix) {
     double cost = 0;
     for (size_t i = 0; i < route.size() - 1; ++i) {
-        cost += costMatrix[route[i]][route[i + 1]];
+        cost += costMatrix(route[i], route[i + 1]);
     }
     return cost;
 }
 
 // Método de Troca de Vizinhos (Swap)
-pair<vector<int>, double> swapNeighbors(const vector<int>& initialPath, const Matrix& costMatrix) {
+// As trocas são feitas no próprio caminho e avaliadas só pelas arestas alteradas (O(1) cada,
+// inclusive quando as duas cidades são vizinhas); o custo é atualizado pela variação.
+pair<vector<int>, double> swapNeighbors(const vector<int>& initialPath, const Matrix& costMatrix,
+                                        ImprovementPolicy policy = ImprovementPolicy::FirstImprovement) {
     vector<int> bestPath = initialPath;
-    double bestCost = calculateRouteCost(bestPath, costMatrix);
-    bool improved = true;
-
-    while (improved) {
-        improved = false;
-        for (size_t i = 1; i < bestPath.size() - 2; ++i) {
-            for (size_t j = i + 1; j < bestPath.size() - 1; ++j) {
-                vector<int> newPath = bestPath;
-                swap(newPath[i], newPath[j]); // Troca as cidades i e j
-                double newCost = calculateRouteCost(newPath, costMatrix);
-
-                if (newCost < bestCost) {
-                    bestPath = newPath;
-                    bestCost = newCost;
-                    improved = true;
-                }
-            }
-        }
-    }
-
+    double bestCost = swapLocalSearch(bestPath, costMatrix, calculateRouteCost(bestPath, costMatrix), policy);
     return {bestPath, bestCost};
 }
 
 // Função para salvar os resultados em um arquivo CSV
-void saveResults(const string& outputFile, const string& mode, const vector<int>& route, double cost, const vector<string>& cities, double executionTime) {
+void saveResults(const string& outputFile, const string& mode, const vector<int>& route, double cost, const vector<string>& cities, double executionTime, double lowerBound) {
     ofstream outFile(outputFile, ios::app);
 
     if (!outFile.is_open()) {
@@ -110,7 +67,7 @@ void saveResults(const string& outputFile, const string& mode, const vector<int>
 
     static bool headerWritten = false;
     if (!headerWritten) {
-        outFile << "Modo,Rota,Custo,Tempo (s)\n";
+        outFile << "Modo,Rota,Custo,Tempo (s),Limite inferior,Gap (%)\n";
         headerWritten = true;
     }
 
@@ -118,26 +75,38 @@ void saveResults(const string& outputFile, const string& mode, const vector<int>
     for (int city : route) {
         outFile << cities[city] << " ";
     }
-    outFile << "\"," << cost << "," << executionTime << "\n";
+    outFile << "\"," << cost << "," << executionTime << "," << lowerBound << "," << optimalityGap(cost, lowerBound) << "\n";
 
     outFile.close();
 }
 
 // Função principal
-int main() {
+// Uso: grasp2 [first|best] (política de aceitação das trocas; padrão first)
+int main(int argc, char* argv[]) {
     // Caminhos dos arquivos
     string distanceFile = "../Km_modificado.csv";
     string timeFile = "../Min_modificado.csv";
     string citiesFile = "../Cidades.csv";
     string outputFile = "../resultados_swap.csv";
 
+    ImprovementPolicy policy = ImprovementPolicy::FirstImprovement;
+    if (argc > 1) {
+        string policyName = argv[1];
+        if (policyName == "best") {
+            policy = ImprovementPolicy::BestImprovement;
+        } else if (policyName != "first") {
+            cerr << "Política desconhecida: " << policyName << " (use first ou best)" << endl;
+            return 1;
+        }
+    }
+
     // Carregar a matriz de distâncias
     cout << "Carregando a matriz de distâncias..." << endl;
-    Matrix distanceMatrix = loadMatrixFromCSV(distanceFile);
+    Matrix distanceMatrix = loadMatrix(distanceFile);
 
     // Carregar a matriz de tempos
     cout << "Carregando a matriz de tempos..." << endl;
-    Matrix timeMatrix = loadMatrixFromCSV(timeFile);
+    Matrix timeMatrix = loadMatrix(timeFile);
 
     // Carregar os nomes das cidades
     cout << "Carregando os nomes das cidades..." << endl;
@@ -149,6 +118,10 @@ int main() {
         return 1;
     }
 
+    // Limites inferiores de Held e Karp, para o gap de cada solução
+    double distanceBound = heldKarpBound(distanceMatrix);
+    double timeBound = heldKarpBound(timeMatrix);
+
     // Inicializar o percurso (0 -> 1 -> 2 -> ... -> n-1 -> 0)
     size_t numCities = distanceMatrix.size();
     vector<int> initialPath(numCities + 1);
@@ -159,21 +132,23 @@ int main() {
 
     // Medir tempo para otimização por distância
     auto start = high_resolution_clock::now();
-    auto [optimizedPathDist, optimizedCostDist] = swapNeighbors(initialPath, distanceMatrix);
+    auto [optimizedPathDist, optimizedCostDist] = swapNeighbors(initialPath, distanceMatrix, policy);
     auto end = high_resolution_clock::now();
     double executionTimeDist = duration_cast<duration<double>>(end - start).count();
 
     cout << "Custo otimizado (Distância - Troca de Vizinhos): " << optimizedCostDist << " | Tempo: " << executionTimeDist << "s" << endl;
-    saveResults(outputFile, "Distância - Troca de Vizinhos", optimizedPathDist, optimizedCostDist, cities, executionTimeDist);
+    cout << "Limite inferior (Distância): " << distanceBound << " | Gap: " << optimalityGap(optimizedCostDist, distanceBound) << "%" << endl;
+    saveResults(outputFile, "Distância - Troca de Vizinhos", optimizedPathDist, optimizedCostDist, cities, executionTimeDist, distanceBound);
 
     // Medir tempo para otimização por tempo
     start = high_resolution_clock::now();
-    auto [optimizedPathTime, optimizedCostTime] = swapNeighbors(initialPath, timeMatrix);
+    auto [optimizedPathTime, optimizedCostTime] = swapNeighbors(initialPath, timeMatrix, policy);
     end = high_resolution_clock::now();
     double executionTimeTime = duration_cast<duration<double>>(end - start).count();
 
     cout << "Custo otimizado (Tempo - Troca de Vizinhos): " << optimizedCostTime << " | Tempo: " << executionTimeTime << "s" << endl;
-    saveResults(outputFile, "Tempo - Troca de Vizinhos", optimizedPathTime, optimizedCostTime, cities, executionTimeTime);
+    cout << "Limite inferior (Tempo): " << timeBound << " | Gap: " << optimalityGap(optimizedCostTime, timeBound) << "%" << endl;
+    saveResults(outputFile, "Tempo - Troca de Vizinhos", optimizedPathTime, optimizedCostTime, cities, executionTimeTime, timeBound);
 
     return 0;
 }
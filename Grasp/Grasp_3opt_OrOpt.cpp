@@ -5,53 +5,24 @@
 #include <random>
 #include <ctime>
 #include <fstream>
-#include <sstream>
 #include <chrono>
-#include <cassert>
+#include <thread>
+#include <atomic>
+#include <cstdlib>
+#include <string>
+
+#include "../Common/CostMatrix.hpp"
+#include "../Common/BinaryMatrix.hpp"
+#include "../Common/NeighborLists.hpp"
+#include "../Common/Deadline.hpp"
+#include "../Common/Grasp.hpp"
+#include "../Common/LowerBound.hpp"
 
 using namespace std;
 using namespace chrono;
 
-// Define um tipo para matriz (vector de vectors de doubles)
-typedef vector<vector<double>> Matrix;
-
-// Cria um gerador de números aleatórios mais robusto
-std::random_device rd;
-std::mt19937 generator(rd());
-
-// Função para carregar a matriz de custos de um arquivo .csv
-Matrix loadMatrixFromCSV(const string& filePath) {
-    Matrix matrix;
-    ifstream file(filePath);
-
-    // Verifica se o arquivo foi aberto com sucesso
-    if (!file.is_open()) {
-        cerr << "Erro ao abrir o arquivo: " << filePath << endl;
-        return matrix;
-    }
-
-    string line;
-    // Lê cada linha do arquivo
-    while (getline(file, line)) {
-        vector<double> row;
-        stringstream ss(line);
-        string value;
-
-        // Lê cada valor da linha separado por vírgula
-        while (getline(ss, value, ',')) {
-            try {
-                row.push_back(stod(value)); // Converte o valor para double
-            } catch (const invalid_argument&) {
-                row.push_back(0); // Se a conversão falhar, adiciona 0
-            }
-        }
-
-        matrix.push_back(row); // Adiciona a linha à matriz
-    }
-
-    file.close(); // Fecha o arquivo
-    return matrix;
-}
+// Define um tipo para matriz (matriz de custos contígua compartilhada)
+typedef CostMatrix<COST_TYPE> Matrix;
 
 // Função para carregar os nomes das cidades de um arquivo CSV
 vector<string> loadCitiesFromCSV(const string& filePath) {
@@ -76,226 +47,81 @@ vector<string> loadCitiesFromCSV(const string& filePath) {
     return cities;
 }
 
-// Função para calcular o custo total de uma rota
-double calculateRouteCost(const vector<int>& route, const Matrix& costMatrix) {
-    double cost = 0;
-    // Calcula o custo de cada trecho da rota
-    for (size_t i = 0; i < route.size() - 1; ++i) {
-        cost += costMatrix[route[i]][route[i + 1]];
-    }
-    cost += costMatrix[route.back()][route.front()]; // Adiciona o custo de voltar à cidade inicial
-    return cost;
-}
-
-// Função de busca local (3-opt)
-void localSearch3Opt(vector<int>& route, const Matrix& costMatrix) {
-    bool improved = true;
-    // Continua enquanto houver melhorias
-    while (improved) {
-        improved = false;
-        // Itera sobre todas as combinações possíveis de 3-opt
-        for (size_t i = 0; i < route.size() - 3; ++i) {
-            assert(i >= 0 && i < route.size() - 3);
-            for (size_t j = i + 1; j < route.size() - 2; ++j) {
-                assert(j > i && j < route.size() - 2);
-                for (size_t k = j + 1; k < route.size() - 1; ++k) {
-                    assert(k > j && k < route.size() - 1);
-
-                    // Gera todas as possíveis trocas 3-opt (6 combinações no total).
-                    vector<vector<int>> newRoutes;
-                    vector<int> tempRoute1 = route;
-                    vector<int> tempRoute2 = route;
-                    vector<int> tempRoute3 = route;
-                    vector<int> tempRoute4 = route;
-                    vector<int> tempRoute5 = route;
-
-                    // 1. Inverte [i+1, j]
-                    reverse(tempRoute1.begin() + i + 1, tempRoute1.begin() + j + 1);
-                    newRoutes.push_back(tempRoute1);
-
-                    // 2. Inverte [j+1, k]
-                    reverse(tempRoute2.begin() + j + 1, tempRoute2.begin() + k + 1);
-                    newRoutes.push_back(tempRoute2);
-
-                    // 3. Inverte [i+1, k]
-                    reverse(tempRoute3.begin() + i + 1, tempRoute3.begin() + k + 1);
-                    newRoutes.push_back(tempRoute3);
-
-                    // 4. Inverte [i+1, j] e [j+1, k]
-                    reverse(tempRoute4.begin() + i + 1, tempRoute4.begin() + j + 1);
-                    reverse(tempRoute4.begin() + j + 1, tempRoute4.begin() + k + 1);
-                    newRoutes.push_back(tempRoute4);
-
-                    // 5. Inverte [i+1, j] e depois inverte [i+1,k]
-                    reverse(tempRoute5.begin() + i + 1, tempRoute5.begin() + j + 1);
-                    vector<int> tempRoute6 = tempRoute5;
-                    reverse(tempRoute6.begin() + i + 1, tempRoute6.begin() + k + 1);
-                    newRoutes.push_back(tempRoute6);
-
-                    // Avalia cada nova rota
-                    for (const auto& newRoute : newRoutes) {
-
-                        double oldCost = calculateRouteCost(route, costMatrix);
-                        double newCost = calculateRouteCost(newRoute, costMatrix);
-                        // Se a nova rota for melhor, atualiza e sai dos laços
-                        if (newCost < oldCost) {
-                            route = newRoute;
-                            improved = true;
-                            break;
-                        }
-                    }
-                    if (improved) break;
-                }
-                if (improved) break;
-            }
-            if (improved) break;
-        }
-    }
-}
-
-// Função de busca local (Or-opt)
-void localSearchOrOpt(vector<int>& route, const Matrix& costMatrix) {
-    bool improved = true;
-    // Continua enquanto houver melhorias
-    while (improved) {
-        improved = false;
-         for (size_t i = 0; i < route.size(); ++i) {
-            assert(i >= 0 && i < route.size());
-
-           vector<int> newRoute = route;
-            auto subPathStart = newRoute.begin() + i;
-            for(int subPathSize = 1; subPathSize <=3 ; subPathSize++){
-                if (i + subPathSize > route.size()) continue;
-                assert(i + subPathSize <= route.size());
-
-                auto subPathEnd = newRoute.begin() + i + subPathSize;
-                assert(subPathEnd >= newRoute.begin() && subPathEnd <= newRoute.end());
-
-                vector<int> subPath(subPathStart, subPathEnd);
-
-                newRoute.erase(subPathStart, subPathEnd);
-
-                 for (size_t j = 0; j < newRoute.size(); ++j) {
-                    if (j == i || j == i - 1 || j == i + 1) continue;
-                    assert(j >= 0 && j < newRoute.size());
-                   auto newPos = newRoute.begin() + j;
-                       
-                       vector<int> tempRoute = newRoute;
-                        tempRoute.insert(newPos, subPath.begin(), subPath.end());
-
-                        double oldCost = calculateRouteCost(route, costMatrix);
-                        double newCost = calculateRouteCost(tempRoute, costMatrix);
-                         if (newCost < oldCost) {
-                            route = tempRoute;
-                            improved = true;
-                             //After changing the vector, update the j index
-                            if(j >= route.size()) j = 0;
-                             break;
-                         }
-
-                 }
-                if (improved) break;
-            }
-             if (improved) break;
-        }
-    }
-}
-
-// Função de construção aleatória-gulosa
-vector<int> greedyRandomizedConstruction(const Matrix& costMatrix, double alpha) {
-    int n = costMatrix.size();
-    vector<int> route = {0}; // Começa na cidade 0
-    vector<bool> visited(n, false); // Marca as cidades visitadas
-    visited[0] = true; // Cidade inicial marcada como visitada
-
-    // Enquanto houver cidades a serem visitadas
-    while (route.size() < n) {
-        int currentCity = route.back(); // Pega a última cidade visitada
-        vector<pair<int, double>> candidates;
-
-        // Adiciona à lista de candidatos as cidades não visitadas
-        for (int i = 0; i < n; ++i) {
-            if (!visited[i]) {
-                candidates.emplace_back(i, costMatrix[currentCity][i]);
-            }
-        }
-
-        // Ordena os candidatos pelo custo
-        sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
-            return a.second < b.second;
-        });
-
-        // Calcula o limiar para a lista restrita de candidatos
-        double minCost = candidates.front().second;
-        double maxCost = candidates.back().second;
-        double threshold = minCost + alpha * (maxCost - minCost);
-
-        vector<int> restrictedCandidates;
-         // Adiciona à lista restrita os candidatos cujo custo está abaixo do limiar
-        for (const auto& candidate : candidates) {
-            if (candidate.second <= threshold) {
-                restrictedCandidates.push_back(candidate.first);
-            }
-        }
-
-        assert(!restrictedCandidates.empty());
-        // Escolhe uma cidade aleatoriamente da lista restrita
-        uniform_int_distribution<int> distribution(0, restrictedCandidates.size() - 1);
-        int chosenCity = restrictedCandidates[distribution(generator)];
-
-        route.push_back(chosenCity);  // Adiciona a cidade à rota
-        visited[chosenCity] = true; // Marca a cidade como visitada
-    }
-
-    return route;
-}
-
-// Função principal do algoritmo GRASP
-pair<vector<int>, double> grasp(const Matrix& costMatrix, int maxIterations, double alpha, bool use3Opt) {
-    vector<int> bestRoute;
-    double bestCost = numeric_limits<double>::infinity();
-
-    // Executa o GRASP por um número máximo de iterações
-    for (int iter = 0; iter < maxIterations; ++iter) {
-        // Construção aleatória-gulosa
-        vector<int> route = greedyRandomizedConstruction(costMatrix, alpha);
-
-        // Busca local
-        if (use3Opt)
-            localSearch3Opt(route, costMatrix);
-        else
-            localSearchOrOpt(route, costMatrix);
-
-        // Avalia a solução
-        double cost = calculateRouteCost(route, costMatrix);
-        if (cost < bestCost) {
-            bestCost = cost;
-            bestRoute = route;
+// Imprime as estatísticas de cada alpha do GRASP reativo
+void printAlphaStats(const ReactiveAlpha& reactive) {
+    cout << "Alphas (GRASP reativo):" << endl;
+    for (const AlphaStats& entry : reactive.stats()) {
+        cout << "  alpha " << entry.alpha << " | iterações " << entry.iterations;
+        if (entry.iterations > 0) {
+            cout << " | custo médio " << entry.averageCost() << " | melhor " << entry.bestCost;
         }
+        cout << " | probabilidade " << entry.probability << endl;
     }
-
-    // Adiciona o retorno para a cidade inicial na melhor rota
-    bestRoute.push_back(0);
-    bestCost = calculateRouteCost(bestRoute, costMatrix);
-
-    return {bestRoute, bestCost};
 }
 
 // Função principal para testar o algoritmo GRASP
-int main() {
+// Uso: grasp3opt [2opt|3opt|oropt|lk] [reactive] [pr-forward|pr-backward|pr-mixed] [time=<s>] [trace=<prefixo>]
+//                [gap=<%>]
+// Sem busca local na linha de comando: 3-opt para distância e Or-opt para tempo. Com reactive,
+// alpha é escolhido pelo GRASP reativo no lugar do valor fixo; pr-* liga a religação de
+// caminhos com a elite no sentido escolhido. time= troca o número fixo de iterações por um
+// prazo em segundos para cada matriz, e trace= grava o traço de convergência de cada matriz em
+// <prefixo>_distancia.csv e <prefixo>_tempo.csv. Cada solução sai com o limite inferior de Held
+// e Karp da matriz e o gap até ele; gap= para o GRASP assim que o gap fica abaixo da tolerância.
+int main(int argc, char* argv[]) {
     // Caminhos dos arquivos
     string distanceFile = "../Km_modificado.csv";
     string timeFile = "../Min_modificado.csv";
     string citiesFile = "../Cidades.csv";
     string outputFile = "../resultados_swap.csv";
 
+    // Busca local de cada matriz, opcionalmente trocada pela linha de comando
+    LocalSearchMethod distanceMethod = LocalSearchMethod::ThreeOpt;
+    LocalSearchMethod timeMethod = LocalSearchMethod::OrOpt;
+    bool reactiveAlpha = false;
+    PathRelinkingOptions relinking;
+    double timeLimit = 0.0;
+    string tracePrefix;
+    double gapTolerance = -1.0; // Em porcentagem (negativo: sem parada pelo gap)
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg.rfind("time=", 0) == 0) {
+            char* end = nullptr;
+            timeLimit = strtod(arg.c_str() + 5, &end);
+            if (*end != '\0' || timeLimit <= 0) {
+                cerr << "Limite de tempo inválido: " << arg << endl;
+                return 1;
+            }
+        } else if (arg.rfind("gap=", 0) == 0) {
+            char* end = nullptr;
+            gapTolerance = strtod(arg.c_str() + 4, &end);
+            if (*end != '\0' || gapTolerance < 0) {
+                cerr << "Tolerância de gap inválida: " << arg << endl;
+                return 1;
+            }
+        } else if (arg.rfind("trace=", 0) == 0) {
+            tracePrefix = arg.substr(6);
+        } else if (arg == "reactive") {
+            reactiveAlpha = true;
+        } else if (parseRelinkingMode(arg, relinking.mode)) {
+            continue;
+        } else if (parseLocalSearchMethod(arg, distanceMethod)) {
+            timeMethod = distanceMethod;
+        } else {
+            cerr << "Argumento desconhecido: " << arg
+                 << " (use 2opt, 3opt, oropt, lk, reactive, pr-forward|pr-backward|pr-mixed, time=<s>, trace=<prefixo> ou gap=<%>)"
+                 << endl;
+            return 1;
+        }
+    }
+
     // Carregar a matriz de distâncias
     cout << "Carregando a matriz de distâncias..." << endl;
-    Matrix distanceMatrix = loadMatrixFromCSV(distanceFile);
+    Matrix distanceMatrix = loadMatrix(distanceFile);
 
     // Carregar a matriz de tempos
     cout << "Carregando a matriz de tempos..." << endl;
-    Matrix timeMatrix = loadMatrixFromCSV(timeFile);
+    Matrix timeMatrix = loadMatrix(timeFile);
 
     // Carregar os nomes das cidades
     cout << "Carregando os nomes das cidades..." << endl;
@@ -322,12 +148,35 @@ int main() {
         return 1;
     }
 
-    int maxIterations = 100; // Número máximo de iterações do GRASP
-    double alpha = 0.3;  // Controle do nível de aleatoriedade
-
-    // Aplica o GRASP para distância (usando 3-opt)
+    int maxIterations = timeLimit > 0 ? 0 : 100; // Número máximo de iterações do GRASP (0: até o prazo)
+    double alpha = 0.3;  // Controle do nível de aleatoriedade (sem o GRASP reativo)
+    int numThreads = max(1u, thread::hardware_concurrency()); // Threads do GRASP paralelo
+    unsigned seed = random_device{}(); // Semente base dos geradores de cada thread
+    int neighborCount = 10; // Vizinhos candidatos por cidade na busca local (0 desativa)
+    cout << "Threads: " << numThreads << " | Semente: " << seed << endl;
+    if (timeLimit > 0) cout << "Limite de tempo por matriz: " << timeLimit << "s" << endl;
+
+    // Listas de candidatos, montadas uma vez por matriz
+    NeighborLists distanceNeighbors(distanceMatrix, neighborCount);
+    NeighborLists timeNeighbors(timeMatrix, neighborCount);
+
+    // Limites inferiores, para o gap de cada solução e a parada com gap=
+    double distanceBound = heldKarpBound(distanceMatrix);
+    double timeBound = heldKarpBound(timeMatrix);
+    auto targetCost = [gapTolerance](double bound) {
+        return gapTolerance >= 0 ? bound * (1.0 + gapTolerance / 100.0) : -numeric_limits<double>::infinity();
+    };
+
+    // Aplica o GRASP para distância
+    ReactiveAlpha distanceAlphas;
     auto start = high_resolution_clock::now();
-    auto [bestRouteDist, bestCostDist] = grasp(distanceMatrix, maxIterations, alpha, true);
+    Deadline distanceDeadline(timeLimit);
+    ConvergenceTrace distanceTrace(distanceDeadline);
+    auto [bestRouteDist, bestCostDist] = grasp(distanceMatrix, maxIterations, alpha, distanceMethod, numThreads, seed,
+                                               &distanceNeighbors, RclOptions(),
+                                               reactiveAlpha ? &distanceAlphas : nullptr, relinking,
+                                               &distanceDeadline, tracePrefix.empty() ? nullptr : &distanceTrace,
+                                               targetCost(distanceBound));
     auto end = high_resolution_clock::now();
     double elapsedTimeDist = duration_cast<duration<double>>(end - start).count();
 
@@ -337,10 +186,21 @@ int main() {
         cout << city << " ";
     }
     cout << "\nCusto total (Distância): " << bestCostDist << "\nTempo: " << elapsedTimeDist << "s" << endl;
-/*
-     // Aplica o GRASP para tempo (usando Or-opt)
+    cout << "Limite inferior (Distância): " << distanceBound << " | Gap: " << optimalityGap(bestCostDist, distanceBound)
+         << "%" << endl;
+    if (reactiveAlpha) printAlphaStats(distanceAlphas);
+    if (!tracePrefix.empty()) distanceTrace.writeCsv(tracePrefix + "_distancia.csv");
+
+    // Aplica o GRASP para tempo
+    ReactiveAlpha timeAlphas;
     start = high_resolution_clock::now();
-    auto [bestRouteTime, bestCostTime] = grasp(timeMatrix, maxIterations, alpha, false);
+    Deadline timeDeadline(timeLimit);
+    ConvergenceTrace timeTrace(timeDeadline);
+    auto [bestRouteTime, bestCostTime] = grasp(timeMatrix, maxIterations, alpha, timeMethod, numThreads, seed,
+                                               &timeNeighbors, RclOptions(),
+                                               reactiveAlpha ? &timeAlphas : nullptr, relinking,
+                                               &timeDeadline, tracePrefix.empty() ? nullptr : &timeTrace,
+                                               targetCost(timeBound));
     end = high_resolution_clock::now();
     double elapsedTimeTime = duration_cast<duration<double>>(end - start).count();
 
@@ -350,6 +210,10 @@ int main() {
         cout << city << " ";
     }
     cout << "\nCusto total (Tempo): " << bestCostTime << "\nTempo: " << elapsedTimeTime << "s" << endl;
-*/
+    cout << "Limite inferior (Tempo): " << timeBound << " | Gap: " << optimalityGap(bestCostTime, timeBound) << "%"
+         << endl;
+    if (reactiveAlpha) printAlphaStats(timeAlphas);
+    if (!tracePrefix.empty()) timeTrace.writeCsv(tracePrefix + "_tempo.csv");
+
     return 0;
 }
\ No newline at end of file
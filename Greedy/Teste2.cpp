@@ -2,45 +2,26 @@
 #include <vector>
 #include <limits>
 #include <fstream>
-#include <sstream>
-#include <cctype>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+
+#include "../Common/CostMatrix.hpp"
+#include "../Common/BinaryMatrix.hpp"
+#include "../Common/NeighborLists.hpp"
+#include "../Common/NearestNeighbor.hpp"
+#include "../Common/Parallel.hpp"
+#include "../Common/LowerBound.hpp"
+
 using namespace std;
+using namespace chrono;
 
-// Função para carregar a matriz de distâncias a partir de um arquivo CSV
-vector<vector<double>> carregarMatriz(const string &nomeArquivo) {
-    ifstream arquivo(nomeArquivo);
-    vector<vector<double>> matriz;
-    string linha;
+typedef CostMatrix<COST_TYPE> Matrix;
 
-    if (!arquivo.is_open()) {
-        cerr << "Erro: Não foi possível abrir o arquivo " << nomeArquivo << endl;
-        exit(1);
-    }
-
-    while (getline(arquivo, linha)) {
-        stringstream ss(linha);
-        string valor;
-        vector<double> linhaMatriz;
-
-        while (getline(ss, valor, ',')) {
-            // Substituir vírgulas por pontos, caso existam
-            for (char &c : valor) {
-                if (c == ',') c = '.';
-            }
-            // Verificar se o valor não está vazio e se é numérico
-            if (!valor.empty() && (isdigit(valor[0]) || valor[0] == '-')) {
-                try {
-                    linhaMatriz.push_back(stod(valor)); // Converte string para double
-                } catch (const invalid_argument &e) {
-                    cerr << "Aviso: Valor inválido ignorado no arquivo: " << valor << endl;
-                    linhaMatriz.push_back(0.0); // Valor padrão
-                }
-            } else {
-                linhaMatriz.push_back(0.0); // Valor padrão para entradas inválidas
-            }
-        }
-        matriz.push_back(linhaMatriz);
-    }
+// Função para carregar a matriz de distâncias a partir de um arquivo CSV
+Matrix carregarMatriz(const string &nomeArquivo) {
+    Matrix matriz = loadMatrix(nomeArquivo);
 
     if (matriz.empty()) {
         cerr << "Erro: O arquivo " << nomeArquivo << " está vazio ou mal formatado." << endl;
@@ -50,53 +31,84 @@ vector<vector<double>> carregarMatriz(const string &nomeArquivo) {
     return matriz;
 }
 
-// Função para encontrar a próxima cidade mais próxima
-int encontrarCidadeMaisProxima(int cidadeAtual, const vector<vector<double>> &distancias, const vector<bool> &visitado) {
-    double menorDistancia = numeric_limits<double>::max(); // Inicializa com valor máximo
-    int proximaCidade = -1;
-
-    for (int i = 0; i < distancias.size(); i++) {
-        if (!visitado[i] && distancias[cidadeAtual][i] < menorDistancia) {
-            menorDistancia = distancias[cidadeAtual][i];
-            proximaCidade = i;
-        }
-    }
-    return proximaCidade;
+// Função principal do algoritmo guloso (vizinho mais próximo)
+// Segue as listas de vizinhos ordenadas, pulando as cidades já visitadas (conjunto de bits);
+// a linha da matriz só é varrida quando a lista da cidade atual se esgota.
+pair<vector<int>, double> algoritmoGuloso(const Matrix &distancias, int cidadeInicial,
+                                          const NeighborLists *vizinhos = nullptr) {
+    NearestNeighborBuilder<COST_TYPE> construtor(distancias, vizinhos);
+    return construtor.build(cidadeInicial);
 }
 
-// Função principal do algoritmo guloso
-pair<vector<int>, double> algoritmoGuloso(const vector<vector<double>> &distancias, int cidadeInicial) {
+// Resultado do guloso rodado a partir de todas as cidades iniciais
+struct ResultadoTodasOrigens {
+    pair<vector<int>, double> melhor; // Melhor rota encontrada e o seu custo
+    int melhorOrigem = -1;            // Cidade inicial da melhor rota
+    vector<double> custos;            // Custo da rota gulosa de cada cidade inicial
+};
+
+// Executa o algoritmo guloso a partir de cada cidade inicial, em paralelo. Cada thread tem o
+// seu construtor (e portanto o seu conjunto de visitadas) reaproveitado entre as origens e só
+// copia a rota quando ela melhora o seu melhor resultado; em caso de empate vence a menor
+// cidade inicial, então o resultado não depende do número de threads.
+ResultadoTodasOrigens algoritmoGulosoTodasOrigens(const Matrix &distancias, const NeighborLists *vizinhos,
+                                                  int numThreads) {
     int n = distancias.size();
-    vector<bool> visitado(n, false); // Vetor para marcar cidades visitadas
-    vector<int> rota;               // Vetor para armazenar a rota
-    double custoTotal = 0.0;        // Custo total da rota
-
-    int cidadeAtual = cidadeInicial;
-    rota.push_back(cidadeAtual);
-    visitado[cidadeAtual] = true;
-
-    // Itera até visitar todas as cidades
-    for (int i = 1; i < n; i++) {
-        int proximaCidade = encontrarCidadeMaisProxima(cidadeAtual, distancias, visitado);
-        if (proximaCidade == -1) {
-            cerr << "Erro: Não foi possível encontrar uma cidade válida." << endl;
-            exit(1);
+    numThreads = max(1, min(numThreads, n));
+    vector<NearestNeighborBuilder<COST_TYPE>> construtores(numThreads, NearestNeighborBuilder<COST_TYPE>(distancias, vizinhos));
+    vector<ResultadoTodasOrigens> melhoresPorThread(numThreads);
+
+    ResultadoTodasOrigens resultado;
+    resultado.custos.assign(n, 0.0);
+
+    parallelFor(n, numThreads, [&](size_t origem, int threadId) {
+        pair<vector<int>, double> rota = construtores[threadId].build(static_cast<int>(origem));
+        resultado.custos[origem] = rota.second;
+
+        ResultadoTodasOrigens &melhor = melhoresPorThread[threadId];
+        if (melhor.melhorOrigem < 0 || rota.second < melhor.melhor.second ||
+            (rota.second == melhor.melhor.second && static_cast<int>(origem) < melhor.melhorOrigem)) {
+            melhor.melhor = move(rota);
+            melhor.melhorOrigem = static_cast<int>(origem);
+        }
+    });
+
+    // Redução entre as threads
+    for (ResultadoTodasOrigens &melhor : melhoresPorThread) {
+        if (melhor.melhorOrigem < 0) continue;
+        if (resultado.melhorOrigem < 0 || melhor.melhor.second < resultado.melhor.second ||
+            (melhor.melhor.second == resultado.melhor.second && melhor.melhorOrigem < resultado.melhorOrigem)) {
+            resultado.melhor = move(melhor.melhor);
+            resultado.melhorOrigem = melhor.melhorOrigem;
         }
-        custoTotal += distancias[cidadeAtual][proximaCidade];
-        cidadeAtual = proximaCidade;
-        rota.push_back(cidadeAtual);
-        visitado[cidadeAtual] = true;
     }
+    return resultado;
+}
 
-    // Retorna à cidade inicial
-    custoTotal += distancias[cidadeAtual][cidadeInicial];
-    rota.push_back(cidadeInicial);
-
-    return make_pair(rota, custoTotal);
+// Imprime a melhor origem e a distribuição dos custos entre as cidades iniciais
+void imprimirDistribuicao(const ResultadoTodasOrigens &resultado, const string &unidade) {
+    vector<double> custos = resultado.custos;
+    sort(custos.begin(), custos.end());
+    size_t n = custos.size();
+
+    double soma = 0.0;
+    for (double custo : custos) soma += custo;
+    double media = soma / n;
+    double variancia = 0.0;
+    for (double custo : custos) variancia += (custo - media) * (custo - media);
+    double desvioPadrao = sqrt(variancia / n);
+    double mediana = n % 2 == 1 ? custos[n / 2] : (custos[n / 2 - 1] + custos[n / 2]) / 2;
+
+    cout << "Melhor cidade inicial: " << resultado.melhorOrigem + 1 << " | Custo: " << resultado.melhor.second << " "
+         << unidade << endl;
+    cout << "Custos das " << n << " cidades iniciais: mínimo " << custos.front() << " | mediana " << mediana
+         << " | média " << media << " | máximo " << custos.back() << " | desvio padrão " << desvioPadrao << endl;
 }
 
 // Função para salvar os resultados em um arquivo
-void salvarResultados(const string &nomeArquivo, const pair<vector<int>, double> &resultado, const string &unidade) {
+// (com o limite inferior de Held e Karp da matriz e a distância da rota até ele)
+void salvarResultados(const string &nomeArquivo, const pair<vector<int>, double> &resultado, const string &unidade,
+                      double limiteInferior) {
     ofstream arquivo(nomeArquivo);
 
     if (!arquivo.is_open()) {
@@ -110,38 +122,72 @@ void salvarResultados(const string &nomeArquivo, const pair<vector<int>, double>
     }
     arquivo << endl;
     arquivo << "Custo total: " << resultado.second << " " << unidade << endl;
+    arquivo << "Limite inferior: " << limiteInferior << " " << unidade << endl;
+    arquivo << "Gap: " << optimalityGap(resultado.second, limiteInferior) << "%" << endl;
 
     arquivo.close();
     cout << "Resultados salvos em " << nomeArquivo << endl;
 }
 
-int main() {
+// Uso: teste [todas] (com "todas", roda o guloso a partir de todas as cidades iniciais)
+int main(int argc, char *argv[]) {
+    bool todasOrigens = argc > 1 && string(argv[1]) == "todas";
+
     // Carregar os dados das distâncias automaticamente (Km_modificado.csv e Min_modificado.csv)
     string arquivoKm = "../Km_modificado.csv";
     string arquivoMin = "../Min_modificado.csv";
 
     cout << "Processando arquivo de distâncias em Km..." << endl;
-    vector<vector<double>> distanciasKm = carregarMatriz(arquivoKm);
+    Matrix distanciasKm = carregarMatriz(arquivoKm);
     cout << "Matriz de distâncias em Km carregada com sucesso. Dimensão: "
-         << distanciasKm.size() << "x" << (distanciasKm.empty() ? 0 : distanciasKm[0].size()) << endl;
+         << distanciasKm.size() << "x" << distanciasKm.size() << endl;
 
     cout << "Processando arquivo de distâncias em Minutos..." << endl;
-    vector<vector<double>> distanciasMin = carregarMatriz(arquivoMin);
+    Matrix distanciasMin = carregarMatriz(arquivoMin);
     cout << "Matriz de distâncias em Minutos carregada com sucesso. Dimensão: "
-         << distanciasMin.size() << "x" << (distanciasMin.empty() ? 0 : distanciasMin[0].size()) << endl;
+         << distanciasMin.size() << "x" << distanciasMin.size() << endl;
 
     // Definir a cidade inicial
     int cidadeInicial = 0; // Começa na primeira cidade (índice 0)
+    int numeroVizinhos = 10; // Tamanho das listas de vizinhos de cada cidade
+
+    // Listas de vizinhos ordenadas, montadas uma vez por matriz
+    NeighborLists vizinhosKm(distanciasKm, numeroVizinhos);
+    NeighborLists vizinhosMin(distanciasMin, numeroVizinhos);
+
+    // Limites inferiores de Held e Karp, para o gap das rotas salvas
+    double limiteKm = heldKarpBound(distanciasKm);
+    double limiteMin = heldKarpBound(distanciasMin);
+
+    if (todasOrigens) {
+        int numThreads = defaultThreadCount();
+        cout << "\nTodas as cidades iniciais (" << numThreads << " threads)" << endl;
+
+        cout << "\nResultados para distâncias em Km:" << endl;
+        auto inicio = high_resolution_clock::now();
+        ResultadoTodasOrigens todasKm = algoritmoGulosoTodasOrigens(distanciasKm, &vizinhosKm, numThreads);
+        cout << "Tempo: " << duration_cast<duration<double>>(high_resolution_clock::now() - inicio).count() << "s" << endl;
+        imprimirDistribuicao(todasKm, "Km");
+        salvarResultados("resultado_km.txt", todasKm.melhor, "Km", limiteKm);
+
+        cout << "\nResultados para distâncias em Minutos:" << endl;
+        inicio = high_resolution_clock::now();
+        ResultadoTodasOrigens todasMin = algoritmoGulosoTodasOrigens(distanciasMin, &vizinhosMin, numThreads);
+        cout << "Tempo: " << duration_cast<duration<double>>(high_resolution_clock::now() - inicio).count() << "s" << endl;
+        imprimirDistribuicao(todasMin, "Minutos");
+        salvarResultados("resultado_minutos.txt", todasMin.melhor, "Minutos", limiteMin);
+        return 0;
+    }
 
     // Executar o algoritmo guloso para Km
     cout << "\nResultados para distâncias em Km:" << endl;
-    pair<vector<int>, double> resultadoKm = algoritmoGuloso(distanciasKm, cidadeInicial);
-    salvarResultados("resultado_km.txt", resultadoKm, "Km");
+    pair<vector<int>, double> resultadoKm = algoritmoGuloso(distanciasKm, cidadeInicial, &vizinhosKm);
+    salvarResultados("resultado_km.txt", resultadoKm, "Km", limiteKm);
 
     // Executar o algoritmo guloso para Min
     cout << "\nResultados para distâncias em Minutos:" << endl;
-    pair<vector<int>, double> resultadoMin = algoritmoGuloso(distanciasMin, cidadeInicial);
-    salvarResultados("resultado_minutos.txt", resultadoMin, "Minutos");
+    pair<vector<int>, double> resultadoMin = algoritmoGuloso(distanciasMin, cidadeInicial, &vizinhosMin);
+    salvarResultados("resultado_minutos.txt", resultadoMin, "Minutos", limiteMin);
 
     return 0;
 }
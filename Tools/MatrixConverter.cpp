@@ -0,0 +1,79 @@
+#include <iostream>
+#include <string>
+#include <cstdint>
+#include <chrono>
+
+#include "../Common/CostMatrix.hpp"
+#include "../Common/CsvLoader.hpp"
+#include "../Common/BinaryMatrix.hpp"
+
+using namespace std;
+using namespace chrono;
+
+// Converte a matriz do CSV para o formato binário com o tipo de elemento T
+template <typename T>
+bool convertMatrix(const string& inputFile, const string& outputFile, bool forceFull) {
+    auto start = high_resolution_clock::now();
+    CostMatrix<T> matrix = loadMatrixFromCSV<T>(inputFile);
+    auto end = high_resolution_clock::now();
+    if (matrix.empty()) {
+        return false;
+    }
+
+    // Matrizes simétricas são gravadas só com o triângulo superior
+    bool symmetric = !forceFull && matrix.isSymmetric();
+    if (!saveMatrixToBinary(matrix, outputFile, symmetric)) {
+        return false;
+    }
+
+    cout << inputFile << " -> " << outputFile << " | Cidades: " << matrix.size()
+         << " | Armazenamento: " << (symmetric ? "triângulo superior" : "completo")
+         << " | Leitura do CSV: " << duration_cast<duration<double>>(end - start).count() << "s" << endl;
+    return true;
+}
+
+// Uso: matrixconverter arquivo.csv [saida.bin] [--type float|double|int32] [--full]
+int main(int argc, char* argv[]) {
+    string inputFile;
+    string outputFile;
+    string type = "double";
+    bool forceFull = false;
+
+    for (int i = 1; i < argc; ++i) {
+        string argument = argv[i];
+        if (argument == "--type" && i + 1 < argc) {
+            type = argv[++i];
+        } else if (argument == "--full") {
+            forceFull = true;
+        } else if (inputFile.empty()) {
+            inputFile = argument;
+        } else if (outputFile.empty()) {
+            outputFile = argument;
+        } else {
+            cerr << "Argumento desconhecido: " << argument << endl;
+            return 1;
+        }
+    }
+
+    if (inputFile.empty()) {
+        cerr << "Uso: " << argv[0] << " arquivo.csv [saida.bin] [--type float|double|int32] [--full]" << endl;
+        return 1;
+    }
+    if (outputFile.empty()) {
+        outputFile = binaryPathFor(inputFile);
+    }
+
+    bool converted;
+    if (type == "float") {
+        converted = convertMatrix<float>(inputFile, outputFile, forceFull);
+    } else if (type == "double") {
+        converted = convertMatrix<double>(inputFile, outputFile, forceFull);
+    } else if (type == "int32") {
+        converted = convertMatrix<int32_t>(inputFile, outputFile, forceFull);
+    } else {
+        cerr << "Tipo desconhecido: " << type << " (use float, double ou int32)" << endl;
+        return 1;
+    }
+
+    return converted ? 0 : 1;
+}
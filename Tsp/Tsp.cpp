@@ -0,0 +1,412 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <cmath>
+#include <limits>
+
+#include "../Common/CostMatrix.hpp"
+#include "../Common/BinaryMatrix.hpp"
+#include "../Common/NeighborLists.hpp"
+#include "../Common/NearestNeighbor.hpp"
+#include "../Common/CheapestInsertion.hpp"
+#include "../Common/LocalSearch.hpp"
+#include "../Common/Deadline.hpp"
+#include "../Common/Grasp.hpp"
+#include "../Common/HeldKarp.hpp"
+#include "../Common/BranchAndBound.hpp"
+#include "../Common/IteratedLocalSearch.hpp"
+#include "../Common/LowerBound.hpp"
+
+using namespace std;
+using namespace chrono;
+
+// Define um tipo para matriz (matriz de custos contígua compartilhada)
+typedef CostMatrix<COST_TYPE> Matrix;
+
+// Fração do prazo (--time) que o limite inferior pode usar; o resto fica para o pipeline
+constexpr double BOUND_TIME_SHARE = 0.25;
+
+// Fração do prazo do GRASP que dá a incumbente do branch-and-bound; o resto fica para a árvore
+constexpr double INCUMBENT_TIME_SHARE = 0.25;
+
+// Construtores da rota inicial (Exact: Held–Karp, só para instâncias pequenas; BranchAndBound:
+// branch-and-bound com limites de 1-árvore, a partir da rota do GRASP)
+enum class Constructor { Greedy, CheapestInsertion, Random, Grasp, Exact, BranchAndBound };
+
+// Etapa de melhoria: troca de vizinhos, uma das buscas locais do driver compartilhado ou a ILS
+// (que usa a busca local de --ils-search)
+struct Improvement {
+    string name;
+    bool swap = false;
+    bool ils = false;
+    LocalSearchMethod method = LocalSearchMethod::TwoOpt;
+};
+
+// Parâmetros da linha de comando
+struct Options {
+    string instance;
+    string output;
+    Constructor constructor = Constructor::Greedy;
+    string constructorName = "greedy";
+    vector<Improvement> improvements;
+    int start = 0;            // Cidade inicial do guloso
+    unsigned seed = 0;        // Semente da rota aleatória e do GRASP
+    bool seedGiven = false;
+    int iterations = 100;     // Iterações do GRASP
+    double alpha = 0.3;       // Aleatoriedade da construção do GRASP
+    int threads = max(1u, thread::hardware_concurrency());
+    int neighbors = 10;       // Vizinhos candidatos por cidade (0 desativa)
+    double timeLimit = 0.0;   // Prazo em segundos para o pipeline inteiro (0: sem prazo)
+    IlsOptions ils;           // Perturbação, aceitação e iterações da ILS
+    LocalSearchMethod ilsSearch = LocalSearchMethod::ThreeOpt;
+    double gap = -1.0;        // Gap (%) até o limite inferior que encerra o GRASP (negativo: desligado)
+    bool bound = false;       // Calcula o limite inferior mesmo sem --gap e --output
+};
+
+bool parseConstructor(const string& name, Constructor& constructor) {
+    if (name == "greedy") constructor = Constructor::Greedy;
+    else if (name == "insertion") constructor = Constructor::CheapestInsertion;
+    else if (name == "random") constructor = Constructor::Random;
+    else if (name == "grasp") constructor = Constructor::Grasp;
+    else if (name == "exact") constructor = Constructor::Exact;
+    else if (name == "bb") constructor = Constructor::BranchAndBound;
+    else return false;
+    return true;
+}
+
+// Lista de melhorias separadas por vírgula, aplicadas na ordem dada (ex.: 2opt,oropt,swap)
+bool parseImprovements(const string& list, vector<Improvement>& improvements) {
+    stringstream stream(list);
+    string name;
+    while (getline(stream, name, ',')) {
+        if (name.empty()) continue;
+        Improvement improvement;
+        improvement.name = name;
+        if (name == "swap") {
+            improvement.swap = true;
+        } else if (name == "ils") {
+            improvement.ils = true;
+        } else if (!parseLocalSearchMethod(name, improvement.method)) {
+            cerr << "Melhoria desconhecida: " << name << " (use swap, 2opt, 3opt, oropt, lk ou ils)" << endl;
+            return false;
+        }
+        improvements.push_back(improvement);
+    }
+    return true;
+}
+
+// Lê o valor numérico de uma opção; false se o texto não for um número
+bool parseNumber(const string& text, double& value) {
+    char* end = nullptr;
+    value = strtod(text.c_str(), &end);
+    return !text.empty() && *end == '\0';
+}
+
+void printUsage(const char* program) {
+    cerr << "Uso: " << program << " arquivo.csv|arquivo.bin [--constructor greedy|insertion|random|grasp|exact|bb]\n"
+         << "       [--improve swap,2opt,3opt,oropt,lk,ils] [--output saida.csv] [--start cidade] [--seed semente]\n"
+         << "       [--iterations n] [--alpha a] [--threads t] [--neighbors k] [--time segundos]\n"
+         << "       [--ils-iterations n] [--ils-search 2opt|3opt|oropt|lk] [--perturbation double-bridge|segment-reversal]\n"
+         << "       [--segment tamanho] [--acceptance better|threshold] [--threshold fração] [--gap porcentagem] [--bound]" << endl;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        double number = 0.0;
+        if (argument == "--bound") {
+            options.bound = true;
+        } else if (argument == "--instance" && hasValue) {
+            options.instance = argv[++i];
+        } else if (argument == "--output" && hasValue) {
+            options.output = argv[++i];
+        } else if (argument == "--constructor" && hasValue) {
+            options.constructorName = argv[++i];
+            if (!parseConstructor(options.constructorName, options.constructor)) {
+                cerr << "Construtor desconhecido: " << options.constructorName
+                     << " (use greedy, insertion, random, grasp, exact ou bb)" << endl;
+                return false;
+            }
+        } else if (argument == "--improve" && hasValue) {
+            if (!parseImprovements(argv[++i], options.improvements)) return false;
+        } else if (argument == "--ils-search" && hasValue) {
+            if (!parseLocalSearchMethod(argv[++i], options.ilsSearch)) {
+                cerr << "Busca local desconhecida: " << argv[i] << " (use 2opt, 3opt, oropt ou lk)" << endl;
+                return false;
+            }
+        } else if (argument == "--perturbation" && hasValue) {
+            if (!parsePerturbation(argv[++i], options.ils.perturbation)) {
+                cerr << "Perturbação desconhecida: " << argv[i] << " (use double-bridge ou segment-reversal)" << endl;
+                return false;
+            }
+        } else if (argument == "--acceptance" && hasValue) {
+            if (!parseAcceptance(argv[++i], options.ils.acceptance)) {
+                cerr << "Aceitação desconhecida: " << argv[i] << " (use better ou threshold)" << endl;
+                return false;
+            }
+        } else if ((argument == "--start" || argument == "--seed" || argument == "--iterations" ||
+                    argument == "--alpha" || argument == "--threads" || argument == "--neighbors" ||
+                    argument == "--time" || argument == "--ils-iterations" || argument == "--segment" ||
+                    argument == "--threshold" || argument == "--gap") && hasValue) {
+            if (!parseNumber(argv[++i], number)) {
+                cerr << "Valor inválido para " << argument << ": " << argv[i] << endl;
+                return false;
+            }
+            if (argument == "--start") {
+                options.start = static_cast<int>(number);
+            } else if (argument == "--seed") {
+                options.seed = static_cast<unsigned>(number);
+                options.seedGiven = true;
+            } else if (argument == "--iterations") {
+                options.iterations = static_cast<int>(number);
+            } else if (argument == "--alpha") {
+                options.alpha = number;
+            } else if (argument == "--threads") {
+                options.threads = max(1, static_cast<int>(number));
+            } else if (argument == "--neighbors") {
+                options.neighbors = max(0, static_cast<int>(number));
+            } else if (argument == "--ils-iterations") {
+                options.ils.iterations = static_cast<int>(number);
+            } else if (argument == "--segment") {
+                options.ils.segmentLength = max(1, static_cast<int>(number));
+            } else if (argument == "--threshold") {
+                options.ils.threshold = number;
+            } else if (argument == "--gap") {
+                options.gap = number;
+            } else {
+                options.timeLimit = number;
+            }
+        } else if (options.instance.empty() && argument.rfind("--", 0) != 0) {
+            options.instance = argument;
+        } else {
+            cerr << "Argumento desconhecido: " << argument << endl;
+            return false;
+        }
+    }
+    if (options.instance.empty()) {
+        printUsage(argv[0]);
+        return false;
+    }
+    return true;
+}
+
+// Carrega a matriz do CSV (ou do .bin mais novo de mesmo nome) ou diretamente de um .bin
+Matrix loadInstance(const string& path) {
+    if (path.size() > 4 && path.compare(path.size() - 4, 4, ".bin") == 0) {
+        return loadMatrixFromBinary<COST_TYPE>(path);
+    }
+    return loadMatrix(path);
+}
+
+// Custo de um caminho fechado (a última cidade repete a primeira)
+double pathCost(const vector<int>& path, const Matrix& costMatrix) {
+    double cost = 0;
+    for (size_t i = 0; i + 1 < path.size(); ++i) {
+        cost += costMatrix(path[i], path[i + 1]);
+    }
+    return cost;
+}
+
+// Rota inicial do construtor escolhido, como caminho fechado (lowerBound encerra o GRASP com --gap;
+// menos infinito se não foi calculado)
+vector<int> construct(const Matrix& costMatrix, const Options& options, const NeighborLists* neighbors,
+                      const Deadline& deadline, double lowerBound) {
+    int n = costMatrix.size();
+    switch (options.constructor) {
+        case Constructor::Greedy: {
+            NearestNeighborBuilder<COST_TYPE> builder(costMatrix, neighbors);
+            return builder.build(options.start).first;
+        }
+        case Constructor::CheapestInsertion:
+            return cheapestInsertion(costMatrix);
+        case Constructor::Random: {
+            // Permutação aleatória a partir da cidade inicial
+            vector<int> path(n);
+            iota(path.begin(), path.end(), 0);
+            swap(path[0], path[options.start]);
+            mt19937 generator(options.seed);
+            shuffle(path.begin() + 1, path.end(), generator);
+            path.push_back(path.front());
+            return path;
+        }
+        case Constructor::Grasp: {
+            // Com prazo, o GRASP roda até ele (e deixa o resto do pipeline sem tempo)
+            int iterations = deadline.limited() ? 0 : options.iterations;
+            double targetCost = options.gap >= 0 ? lowerBound * (1.0 + options.gap / 100.0)
+                                                 : -numeric_limits<double>::infinity();
+            return grasp(costMatrix, iterations, options.alpha, LocalSearchMethod::ThreeOpt, options.threads,
+                         options.seed, neighbors, RclOptions(), nullptr, PathRelinkingOptions(), &deadline, nullptr,
+                         targetCost)
+                .first;
+        }
+        case Constructor::Exact: {
+            auto [path, cost] = heldKarp(costMatrix, options.threads);
+            if (path.empty() && static_cast<size_t>(n) > HELD_KARP_MAX_CITIES) {
+                cerr << "Instância grande demais para o Held-Karp: " << n << " cidades (máximo "
+                     << HELD_KARP_MAX_CITIES << ")" << endl;
+            } else if (path.empty()) {
+                cerr << "Instância grande demais para o Held-Karp: " << n << " cidades precisam de "
+                     << heldKarpMemoryBytes(n) / (1 << 20) << " MB (limite "
+                     << HELD_KARP_DEFAULT_MAX_BYTES / (1 << 20) << " MB)" << endl;
+            }
+            return path;
+        }
+        case Constructor::BranchAndBound: {
+            if (!costMatrix.isSymmetric()) {
+                cerr << "O branch-and-bound só resolve matrizes simétricas" << endl;
+                return {};
+            }
+            // A rota do GRASP é a incumbente inicial; com prazo, o GRASP roda até uma fração dele e a
+            // busca para no resto, sem a prova
+            Deadline incumbentDeadline(options.timeLimit * INCUMBENT_TIME_SHARE);
+            int iterations = deadline.limited() ? 0 : options.iterations;
+            vector<int> incumbent = grasp(costMatrix, iterations, options.alpha, LocalSearchMethod::ThreeOpt,
+                                          options.threads, options.seed, neighbors, RclOptions(), nullptr,
+                                          PathRelinkingOptions(), &incumbentDeadline)
+                                        .first;
+            BranchAndBoundResult result = branchAndBound(costMatrix, incumbent, options.threads, &deadline);
+            cout << "Branch-and-bound: " << result.cost << " | Limite inferior: ";
+            if (std::isinf(result.lowerBound)) {
+                cout << "sem limite";
+            } else {
+                cout << result.lowerBound;
+            }
+            cout << " | Nós: " << result.nodes << " | " << (result.optimal ? "ótimo" : "prazo esgotado") << endl;
+            return result.route;
+        }
+    }
+    return {};
+}
+
+// Aplica uma etapa de melhoria ao caminho fechado, mantendo a cidade inicial
+double improve(vector<int>& path, double cost, const Improvement& improvement, const Matrix& costMatrix,
+               const Options& options, const NeighborLists* neighbors, const Deadline& deadline) {
+    if (improvement.swap) {
+        return swapLocalSearch(path, costMatrix, cost, ImprovementPolicy::FirstImprovement, &deadline);
+    }
+    int start = path.front();
+    vector<int> route(path.begin(), path.end() - 1);
+    if (improvement.ils) {
+        // Com --ils-iterations 0 e --time, a ILS roda até o prazo
+        mt19937 generator(options.seed);
+        iteratedLocalSearch(route, costMatrix, options.ilsSearch, options.ils, generator, neighbors, &deadline);
+    } else {
+        localSearch(route, costMatrix, improvement.method, neighbors, &deadline);
+    }
+    rotate(route.begin(), find(route.begin(), route.end(), start), route.end());
+    route.push_back(start);
+    path.swap(route);
+    return pathCost(path, costMatrix);
+}
+
+// Acrescenta o resultado ao CSV de saída (com cabeçalho se o arquivo for novo)
+bool saveResult(const string& outputFile, const Options& options, const string& pipeline, const vector<int>& path,
+                double cost, double executionTime, double lowerBound) {
+    bool isNew = !ifstream(outputFile).good();
+    ofstream outFile(outputFile, ios::app);
+    if (!outFile.is_open()) {
+        cerr << "Erro ao abrir o arquivo: " << outputFile << endl;
+        return false;
+    }
+    if (isNew) {
+        outFile << "Instancia,Pipeline,Rota,Custo,Tempo (s),Limite inferior,Gap (%)\n";
+    }
+    outFile << options.instance << "," << pipeline << ",";
+    for (size_t i = 0; i < path.size(); ++i) {
+        outFile << (i > 0 ? " " : "") << path[i];
+    }
+    // Sem limite inferior, as duas últimas colunas ficam vazias
+    double gap = optimalityGap(cost, lowerBound);
+    outFile << "," << cost << "," << executionTime << "," << (std::isinf(lowerBound) ? "" : to_string(lowerBound))
+            << "," << (std::isnan(gap) ? "" : to_string(gap)) << "\n";
+    return true;
+}
+
+// Resolve uma instância com um construtor e uma cadeia de melhorias, carregando a matriz uma vez
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+    if (!options.seedGiven) {
+        options.seed = random_device{}();
+    }
+
+    auto loadStart = high_resolution_clock::now();
+    Matrix costMatrix = loadInstance(options.instance);
+    if (costMatrix.empty()) {
+        cerr << "Erro: matriz não carregada: " << options.instance << endl;
+        return 1;
+    }
+    if (options.start < 0 || options.start >= static_cast<int>(costMatrix.size())) {
+        cerr << "Cidade inicial fora da matriz: " << options.start << endl;
+        return 1;
+    }
+    cout << "Instância: " << options.instance << " | Cidades: " << costMatrix.size() << " | Leitura: "
+         << duration_cast<duration<double>>(high_resolution_clock::now() - loadStart).count() << "s" << endl;
+
+    // Listas de candidatos, montadas uma vez e compartilhadas por todas as etapas
+    NeighborLists neighbors(costMatrix, options.neighbors);
+
+    Deadline deadline(options.timeLimit);
+
+    // Limite inferior de Held e Karp, só quando usado (--bound, --gap ou --output). Com --time, ele
+    // tem uma fração do prazo, que continua contando o tempo gasto aqui
+    double lowerBound = -numeric_limits<double>::infinity();
+    if (options.bound || options.gap >= 0 || !options.output.empty()) {
+        Deadline boundDeadline(options.timeLimit * BOUND_TIME_SHARE);
+        auto boundStart = high_resolution_clock::now();
+        lowerBound = heldKarpBound(costMatrix, numeric_limits<double>::infinity(), LOWER_BOUND_ITERATIONS,
+                                   &boundDeadline);
+        double boundTime = duration_cast<duration<double>>(high_resolution_clock::now() - boundStart).count();
+        if (std::isinf(lowerBound)) {
+            cout << "Limite inferior: sem limite (prazo esgotado) | Tempo: " << boundTime << "s" << endl;
+        } else {
+            cout << "Limite inferior: " << lowerBound << (boundDeadline.expired() ? " (parcial, prazo esgotado)" : "")
+                 << " | Tempo: " << boundTime << "s" << endl;
+        }
+    }
+    auto start = high_resolution_clock::now();
+
+    auto stageStart = high_resolution_clock::now();
+    vector<int> path = construct(costMatrix, options, &neighbors, deadline, lowerBound);
+    if (path.empty()) {
+        return 1;
+    }
+    double cost = pathCost(path, costMatrix);
+    string pipeline = options.constructorName;
+    cout << "Construção (" << options.constructorName << "): " << cost << " | Tempo: "
+         << duration_cast<duration<double>>(high_resolution_clock::now() - stageStart).count() << "s" << endl;
+
+    for (const Improvement& improvement : options.improvements) {
+        stageStart = high_resolution_clock::now();
+        cost = improve(path, cost, improvement, costMatrix, options, &neighbors, deadline);
+        pipeline += "+" + improvement.name;
+        cout << "Melhoria (" << improvement.name << "): " << cost << " | Tempo: "
+             << duration_cast<duration<double>>(high_resolution_clock::now() - stageStart).count() << "s" << endl;
+    }
+    double elapsed = duration_cast<duration<double>>(high_resolution_clock::now() - start).count();
+
+    cout << "Rota encontrada: ";
+    for (int city : path) {
+        cout << city << " ";
+    }
+    cout << "\nCusto total: " << cost << "\nTempo: " << elapsed << "s" << endl;
+    if (!std::isinf(lowerBound)) {
+        cout << "Gap até o limite inferior: " << optimalityGap(cost, lowerBound) << "%" << endl;
+    }
+
+    if (!options.output.empty() && !saveResult(options.output, options, pipeline, path, cost, elapsed, lowerBound)) {
+        return 1;
+    }
+    return 0;
+}